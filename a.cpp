@@ -1,6 +1,8 @@
 #include <bits/stdc++.h>
 #include <gmpxx.h>
 
+#include "input.h"
+
 
 class mpf_point {
 public:
@@ -35,8 +37,8 @@ bool intersect(mpf_point &p, mpf_point &q, mpf_point &a, mpf_point &b) {
 
 
 void solveA() {
-    int test_num;
-    std::cin >> test_num;
+    input_reader reader;
+    int test_num = reader.read<int>();
     std::vector<double> input = genTest(test_num);
     std::string ans;
 
@@ -57,8 +59,8 @@ void solveA() {
 
 int main() {
     std::ios_base::sync_with_stdio(false);
-    std::cin.tie(NULL);
     solveA();
+    return 0;
 }
 
 
@@ -2,33 +2,8 @@
 #include <cmath>
 #include <iomanip>
 
-template<typename T>
-class point {
-public:
-    T x;
-    T y;
-
-    point() = default;
-
-    point(T x, T y) : x(x), y(y) {}
-
-    friend std::istream &operator>>(std::istream &is, point<T> &p) {
-        is >> p.x >> p.y;
-        return is;
-    }
-};
-
-//pq and pa
-template<typename T>
-T cross_product(point<T> &a, point<T> &p, point<T> &q) {
-    return (q.x - p.x) * (a.y - p.y) - (q.y - p.y) * (a.x - p.x);
-}
-
-template<typename T>
-int left_turn(point<T> &a, point<T> &p, point<T> &q) {
-    T sgn_square = cross_product(a, p, q);
-    return (sgn_square > 0) - (sgn_square < 0);
-}
+#include "geometry.h"
+#include "input.h"
 
 //pq and pa
 template<typename T>
@@ -36,20 +11,15 @@ T scalar_product(point<T> &a, point<T> &p, point<T> &q) {
     return (q.x - p.x) * (a.x - p.x) + (q.y - p.y) * (a.y - p.y);
 }
 
-template<typename T>
-long double squared_distance(point<T> &a, point<T> &b) {
-    return (a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y);
-}
-
 template<typename T>
 long double distance(point<T> &a, point<T> &b) {
-    return sqrt(squared_distance(a, b));
+    return sqrt((long double) squared_distance(a, b));
 }
 
 //correct
 template<typename T>
-long double distance_to_segment(point<T> &a, point<T> &p, point<T> &q) {
-    return std::abs(cross_product(a, p, q)) / distance(p, q);
+long double distance_to_line(point<T> &a, point<T> &p, point<T> &q) {
+    return std::abs((long double) cross_product(p, q, a)) / distance(p, q);
 }
 
 //correct
@@ -59,7 +29,7 @@ long double distance_to_ray(point<T> &a, point<T> &p, point<T> &q) {
     if (scalar_product(a, p, q) < 0) {
         return distance(a, p);
     }
-    return distance_to_segment(a, p, q);
+    return distance_to_line(a, p, q);
 }
 
 //correct
@@ -72,7 +42,7 @@ long double distance_to_segment(point<T> &a, point<T> &p, point<T> &q) {
     if (projection > squared_distance(p, q)) {
         return distance(a, q);
     }
-    return distance_to_segment(a, p, q);
+    return distance_to_line(a, p, q);
 }
 
 
@@ -172,7 +142,7 @@ long double segment_line_distance(point<T> &a, point<T> &b, point<T> &p, point<T
     if (is_intersect_segment_line(a, b, p, q)) {
         return 0;
     }
-    return std::min(distance_to_segment(a, p, q), distance_to_segment(b, p, q));
+    return std::min(distance_to_line(a, p, q), distance_to_line(b, p, q));
 }
 
 template<typename T>
@@ -213,7 +183,7 @@ long double ray_line_distance(point<T> &a, point<T> &b, point<T> &p, point<T> &q
     if (is_intersect_ray_line(a, b, p, q)) {
         return 0;
     }
-    return distance_to_segment(a, p, q);
+    return distance_to_line(a, p, q);
 }
 
 template<typename T>
@@ -222,19 +192,19 @@ long double line_line_distance(point<T> &a, point<T> &b, point<T> &p, point<T> &
     if (loc.first != parallel) {
         return 0;
     }
-    return distance_to_segment(a, p, q);
+    return distance_to_line(a, p, q);
 }
 
 
 int main() {
-    point<long long> a;
-    point<long long> b;
-    point<long long> c;
-    point<long long> d;
-    std::cin >> a >> b >> c >> d;
+    input_reader input;
+    point<long long> a = input.read_point<long long>();
+    point<long long> b = input.read_point<long long>();
+    point<long long> c = input.read_point<long long>();
+    point<long long> d = input.read_point<long long>();
     int precision = 13;
     std::cout << std::fixed << std::setprecision(precision) << distance(a, c) << '\n';
-    std::cout << std::fixed << std::setprecision(precision) << distance_to_segment(a, c, d) << '\n';
+    std::cout << std::fixed << std::setprecision(precision) << distance_to_line(a, c, d) << '\n';
     std::cout << std::fixed << std::setprecision(precision) << distance_to_ray(a, c, d) << '\n';
     std::cout << std::fixed << std::setprecision(precision) << distance_to_segment(a, c, d) << '\n';
 
@@ -248,11 +218,11 @@ int main() {
     std::cout << std::fixed << std::setprecision(precision) << ray_ray_distance(a, b, c, d) << '\n';
     std::cout << std::fixed << std::setprecision(precision) << ray_line_distance(a, b, c, d) << '\n';
 
-    std::cout << std::fixed << std::setprecision(precision) << distance_to_segment(c, a, b) << '\n';
+    std::cout << std::fixed << std::setprecision(precision) << distance_to_line(c, a, b) << '\n';
     std::cout << std::fixed << std::setprecision(precision) << segment_line_distance(c, d, a, b) << '\n';
     std::cout << std::fixed << std::setprecision(precision) << ray_line_distance(c, d, a, b) << '\n';
     std::cout << std::fixed << std::setprecision(precision) << line_line_distance(a, b, c, d) << '\n';
-
+    return 0;
 }
 
 
@@ -0,0 +1,371 @@
+#include <bits/stdc++.h>
+#include <gmpxx.h>
+#include <benchmark/benchmark.h>
+
+#include "geometry.h"
+#include "input.h"
+#include "output.h"
+
+// every solution is compiled into its own namespace with its main renamed, so the kernels are called directly
+// and nothing is read from stdin; build with -DCMAKE_BUILD_TYPE=Release for meaningful numbers
+#define main solution_main
+
+namespace a {
+// the generator a.cpp expects from the judge: test_num segment pairs as 8 doubles each
+std::vector<double> genTest(int test_num) {
+    std::mt19937_64 random(test_num);
+    std::uniform_real_distribution<double> coordinate(-1e9, 1e9);
+    std::vector<double> input(8 * (size_t) test_num);
+    for (double &value : input) {
+        value = coordinate(random);
+    }
+    return input;
+}
+
+#include "a.cpp"
+}
+
+namespace b {
+#include "b.cpp"
+}
+
+namespace c {
+#include "c.cpp"
+}
+
+namespace d {
+#include "d.cpp"
+}
+
+namespace e {
+#include "e.cpp"
+}
+
+namespace f {
+#include "f.cpp"
+}
+
+namespace g {
+#include "g.cpp"
+}
+
+namespace h {
+#include "h.cpp"
+}
+
+namespace i {
+#include "i.cpp"
+}
+
+namespace j {
+#include "j.cpp"
+}
+
+namespace k {
+#include "k.cpp"
+}
+
+#undef main
+
+enum distribution {
+    // uniform in the square
+    UNIFORM,
+    // a few tight gaussian clusters
+    CLUSTERED,
+    // close to a circle, so almost every point is on the hull
+    CIRCLE
+};
+
+// the same seed for the same size and distribution, so runs are comparable
+std::mt19937_64 make_random(int64_t n, int d) {
+    return std::mt19937_64(0x9e3779b97f4a7c15ULL ^ (uint64_t) (n * 3 + d));
+}
+
+template<typename T>
+std::vector<point<T>> random_points(int64_t n, int d, T range) {
+    std::mt19937_64 random = make_random(n, d);
+    std::uniform_int_distribution<T> coordinate(-range, range);
+    std::normal_distribution<double> normal(0, range / 64.0);
+    std::uniform_real_distribution<double> angle(0, 2 * M_PI);
+    std::vector<point<T>> centres(8);
+    for (point<T> &centre : centres) {
+        centre = point<T>(coordinate(random) / 2, coordinate(random) / 2);
+    }
+    std::vector<point<T>> points(n);
+    for (point<T> &p : points) {
+        if (d == UNIFORM) {
+            p = point<T>(coordinate(random), coordinate(random));
+        } else if (d == CLUSTERED) {
+            point<T> centre = centres[random() % centres.size()];
+            p = point<T>(centre.x + (T) normal(random), centre.y + (T) normal(random));
+        } else {
+            double a = angle(random);
+            p = point<T>((T) (range * std::cos(a)), (T) (range * std::sin(a)));
+        }
+    }
+    return points;
+}
+
+// counter-clockwise strictly convex polygon: Andrew's monotone chain over random points
+template<typename T>
+std::vector<point<T>> random_convex_polygon(int64_t n, T range) {
+    std::vector<point<T>> points = random_points<T>(n, CIRCLE, range);
+    std::sort(points.begin(), points.end());
+    points.erase(std::unique(points.begin(), points.end()), points.end());
+    std::vector<point<T>> hull(2 * points.size());
+    size_t size = 0;
+    for (size_t pass = 0; pass < 2; pass++) {
+        size_t start = size;
+        for (const point<T> &p : points) {
+            while (size >= start + 2 && left_turn(hull[size - 2], hull[size - 1], p) <= 0) {
+                size--;
+            }
+            hull[size++] = p;
+        }
+        size--;
+        std::reverse(points.begin(), points.end());
+    }
+    hull.resize(size);
+    return hull;
+}
+
+// counter-clockwise star-shaped polygon around the origin, simple by construction
+template<typename T>
+std::vector<point<T>> random_star_polygon(int64_t n, T range) {
+    std::mt19937_64 random = make_random(n, UNIFORM);
+    std::uniform_real_distribution<double> unit(0, 1);
+    std::vector<point<T>> polygon(n);
+    for (int64_t v = 0; v < n; v++) {
+        double a = 2 * M_PI * (v + unit(random) * 0.5) / n;
+        double r = range * (0.5 + 0.5 * unit(random));
+        polygon[v] = point<T>((T) (r * std::cos(a)), (T) (r * std::sin(a)));
+    }
+    return polygon;
+}
+
+// the rate counter inverted is seconds per element, reported with an SI prefix (n for nanoseconds)
+void report(benchmark::State &state, int64_t elements) {
+    state.SetItemsProcessed(state.iterations() * elements);
+    state.counters["per_element"] = benchmark::Counter((double) elements,
+                                                       benchmark::Counter::kIsIterationInvariantRate |
+                                                       benchmark::Counter::kInvert);
+    state.SetComplexityN(state.range(0));
+}
+
+void BM_intersect(benchmark::State &state) {
+    int pairs = (int) state.range(0);
+    std::vector<double> input = a::genTest(pairs);
+    std::vector<a::mpf_point> points;
+    points.reserve(4 * (size_t) pairs);
+    for (size_t v = 0; v < input.size(); v += 2) {
+        points.emplace_back(input[v], input[v + 1]);
+    }
+    for (auto _ : state) {
+        int count = 0;
+        for (size_t v = 0; v < points.size(); v += 4) {
+            count += a::intersect(points[v], points[v + 1], points[v + 2], points[v + 3]);
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    report(state, pairs);
+}
+
+void BM_segments_distance(benchmark::State &state, int d) {
+    int64_t pairs = state.range(0);
+    std::vector<point<long long>> points = random_points<long long>(4 * pairs, d, 1000000000);
+    for (auto _ : state) {
+        long double sum = 0;
+        for (size_t v = 0; v < points.size(); v += 4) {
+            sum += b::segments_distance(points[v], points[v + 1], points[v + 2], points[v + 3]);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    report(state, pairs);
+}
+
+void BM_min_distance_between_dots(benchmark::State &state, int d) {
+    int64_t n = state.range(0);
+    std::vector<point<long long>> points = random_points<long long>(n, d, 1000000000);
+    for (auto _ : state) {
+        // the kernel sorts its argument, the copy is O(n) next to O(n log n)
+        std::vector<point<long long>> dots = points;
+        benchmark::DoNotOptimize(c::min_distance_between_dots(dots));
+    }
+    report(state, n);
+}
+
+const int QUERIES = 1 << 12;
+
+void BM_is_inside_convex_polygon(benchmark::State &state) {
+    int64_t n = state.range(0);
+    std::vector<point<long long>> polygon = random_convex_polygon<long long>(n, 1000000000);
+    // prepared the way solveD does it
+    std::reverse(polygon.begin(), polygon.end());
+    d::set_left_point_to_head(polygon);
+    std::vector<point<long long>> queries = random_points<long long>(QUERIES, UNIFORM, 1000000000);
+    for (auto _ : state) {
+        int inside = 0;
+        for (point<long long> &q : queries) {
+            inside += d::is_inside_convex_polygon(q, polygon);
+        }
+        benchmark::DoNotOptimize(inside);
+    }
+    report(state, QUERIES);
+    state.SetComplexityN((int64_t) polygon.size());
+}
+
+void BM_is_in_polygon(benchmark::State &state) {
+    int64_t n = state.range(0);
+    std::vector<point<int>> polygon = random_star_polygon<int>(n, 1000000);
+    std::vector<point<int>> queries = random_points<int>(64, UNIFORM, 1000000);
+    for (auto _ : state) {
+        int inside = 0;
+        for (point<int> &q : queries) {
+            inside += e::is_in_polygon(q, polygon);
+        }
+        benchmark::DoNotOptimize(inside);
+    }
+    // every query walks the whole border, so the element is a query-edge pair
+    report(state, (int64_t) queries.size() * n);
+    state.SetComplexityN(n);
+}
+
+void BM_convex_hull(benchmark::State &state, int d) {
+    int64_t n = state.range(0);
+    std::vector<point<long long>> points = random_points<long long>(n, d, 1000000000);
+    for (auto _ : state) {
+        std::vector<point<long long>> copy = points;
+        benchmark::DoNotOptimize(f::convex_hull(copy));
+    }
+    report(state, n);
+}
+
+void BM_polygons_distance(benchmark::State &state) {
+    int64_t n = state.range(0);
+    std::vector<point<long long>> p = random_convex_polygon<long long>(n, 1000000000);
+    std::vector<point<long long>> q = random_convex_polygon<long long>(n + 1, 1000000000);
+    for (point<long long> &v : q) {
+        v.x += 3000000000LL;
+    }
+    // read_polygon reverses its input
+    std::reverse(p.begin(), p.end());
+    std::reverse(q.begin(), q.end());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(g::polygons_distance(p, q));
+    }
+    report(state, (int64_t) (p.size() + q.size()));
+}
+
+void BM_find_intersection(benchmark::State &state, bool disjoint) {
+    int64_t n = state.range(0);
+    std::mt19937_64 random = make_random(n, disjoint);
+    std::uniform_int_distribution<int> coordinate(-1000000, 1000000);
+    std::vector<int> rows(n);
+    std::iota(rows.begin(), rows.end(), 0);
+    std::shuffle(rows.begin(), rows.end(), random);
+    h::segment_table<int> segments;
+    for (int64_t s = 0; s < n; s++) {
+        if (!disjoint) {
+            // long random segments, a crossing shows up after a few events
+            segments.add({coordinate(random), coordinate(random)}, {coordinate(random), coordinate(random)});
+        } else {
+            // disjoint slanted segments in their own horizontal strips: the sweep runs to the end
+            int x1 = coordinate(random);
+            int x2 = coordinate(random);
+            segments.add({x1, 2 * rows[s]}, {x2, 2 * rows[s] + 1});
+        }
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(h::find_intersection(segments));
+    }
+    report(state, n);
+}
+
+// the sweep's event sort, radix against std::sort, to place RADIX_SORT_THRESHOLD at the crossover
+void BM_sort_events(benchmark::State &state, bool radix) {
+    int64_t n = state.range(0);
+    std::vector<point<int>> ends = random_points<int>(n, UNIFORM, 1000000000);
+    h::sweep_input<int> input;
+    for (int64_t s = 0; s + 1 < n; s += 2) {
+        input.add(ends[s], ends[s + 1]);
+    }
+    for (auto _ : state) {
+        // both sorts work in place, the copy costs the same on both sides
+        std::vector<h::event<int>> events = input.events;
+        if (radix) {
+            h::radix_sort_events(events);
+        } else {
+            std::sort(events.begin(), events.end());
+        }
+        benchmark::DoNotOptimize(events.data());
+    }
+    report(state, (int64_t) input.events.size());
+}
+
+void BM_triangulate(benchmark::State &state) {
+    int64_t n = state.range(0);
+    std::vector<point<int>> polygon = random_star_polygon<int>(n, 1000000);
+    i::diagonal_graph graph;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(i::triangulate(polygon, graph));
+    }
+    report(state, n);
+}
+
+void BM_lines_to_DCEL(benchmark::State &state) {
+    int64_t n = state.range(0);
+    std::vector<point<int>> ends = random_points<int>(2 * n, UNIFORM, 1000000);
+    std::vector<j::line<int>> lines;
+    for (int64_t l = 0; l < n; l++) {
+        if (!(ends[2 * l] == ends[2 * l + 1])) {
+            lines.emplace_back(ends[2 * l], ends[2 * l + 1]);
+        }
+    }
+    for (auto _ : state) {
+        j::DCEL dcel;
+        // a single thread keeps the numbers reproducible across machines
+        j::lines_to_DCEL(lines, dcel, 1);
+        benchmark::DoNotOptimize(dcel.edges.data());
+    }
+    // the arrangement has ~n^2 / 2 vertices
+    report(state, n * n / 2);
+}
+
+void BM_diameter(benchmark::State &state, int d) {
+    int64_t n = state.range(0);
+    std::vector<point<long long>> points = random_points<long long>(n, d, 1000000000);
+    for (auto _ : state) {
+        std::vector<point<long long>> copy = points;
+        benchmark::DoNotOptimize(k::diameter(copy));
+    }
+    report(state, n);
+}
+
+// one family per distribution, so every scaling curve is fitted over a single distribution
+#define DISTRIBUTIONS(kernel, ...) \
+    BENCHMARK_CAPTURE(kernel, uniform, UNIFORM)__VA_ARGS__; \
+    BENCHMARK_CAPTURE(kernel, clustered, CLUSTERED)__VA_ARGS__; \
+    BENCHMARK_CAPTURE(kernel, circle, CIRCLE)__VA_ARGS__
+
+BENCHMARK(BM_intersect)->RangeMultiplier(4)->Range(1 << 8, 1 << 14)->Complexity(benchmark::oN);
+DISTRIBUTIONS(BM_segments_distance, ->RangeMultiplier(8)->Range(1 << 8, 1 << 14)->Complexity(benchmark::oN));
+DISTRIBUTIONS(BM_min_distance_between_dots, ->RangeMultiplier(4)->Range(1 << 10, 1 << 18)
+        ->Complexity(benchmark::oNLogN));
+BENCHMARK(BM_is_inside_convex_polygon)->RangeMultiplier(8)->Range(1 << 6, 1 << 18)->Complexity(benchmark::oLogN);
+BENCHMARK(BM_is_in_polygon)->RangeMultiplier(4)->Range(1 << 8, 1 << 16)->Complexity(benchmark::oN);
+DISTRIBUTIONS(BM_convex_hull, ->RangeMultiplier(4)->Range(1 << 10, 1 << 18)->Complexity(benchmark::oNLogN));
+BENCHMARK(BM_polygons_distance)->RangeMultiplier(4)->Range(1 << 8, 1 << 16)->Complexity(benchmark::oN);
+BENCHMARK_CAPTURE(BM_find_intersection, random, false)->RangeMultiplier(4)->Range(1 << 10, 1 << 18)
+        ->Complexity(benchmark::oNLogN);
+BENCHMARK_CAPTURE(BM_find_intersection, disjoint, true)->RangeMultiplier(4)->Range(1 << 10, 1 << 18)
+        ->Complexity(benchmark::oNLogN);
+BENCHMARK_CAPTURE(BM_sort_events, std_sort, false)->RangeMultiplier(2)->Range(1 << 8, 1 << 20)
+        ->Complexity(benchmark::oNLogN);
+BENCHMARK_CAPTURE(BM_sort_events, radix, true)->RangeMultiplier(2)->Range(1 << 8, 1 << 20)
+        ->Complexity(benchmark::oN);
+BENCHMARK(BM_triangulate)->RangeMultiplier(4)->Range(1 << 8, 1 << 18)->Complexity(benchmark::oNLogN);
+BENCHMARK(BM_lines_to_DCEL)->RangeMultiplier(2)->Range(1 << 5, 1 << 9)->Complexity(benchmark::oNSquared)
+        ->Unit(benchmark::kMillisecond);
+DISTRIBUTIONS(BM_diameter, ->RangeMultiplier(4)->Range(1 << 10, 1 << 18)->Complexity(benchmark::oNLogN));
+
+BENCHMARK_MAIN();
@@ -4,22 +4,8 @@
 #include <cassert>
 #include <cmath>
 
-
-template<typename T>
-class point {
-public:
-    T x;
-    T y;
-
-    point() = default;
-
-    point(T x, T y) : x(x), y(y) {}
-};
-
-template<typename T>
-T squared_distance(point<T> a, point<T> b) {
-    return (a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y);
-}
+#include "geometry.h"
+#include "input.h"
 
 template<typename T>
 class min_distance_result {
@@ -58,6 +44,7 @@ min_distance_result<T> min_distance_trivial(std::vector<point<T>> &dots, int l,
 
 template<typename T>
 int is_close(point<T> a, T split_x, T min_squared_distance) {
+    INSTRUMENT_COUNT("is_close");
     return (a.x - split_x) * (a.x - split_x) < min_squared_distance;
 }
 
@@ -101,14 +88,14 @@ min_distance_result<T> min_distance_between_dots(std::vector<point<T>> &dots) {
 
 
 void solveC() {
-    int n;
-    std::cin >> n;
-    std::vector<point<long long>> dots(n);
-    for (int i = 0; i < n; i++) {
-        long long x, y;
-        std::cin >> x >> y;
-        dots[i] = point<long long>(x, y);
+    std::vector<point<long long>> dots;
+    {
+        INSTRUMENT_PHASE("read");
+        input_reader input;
+        int n = input.read<int>();
+        dots = input.read_points<long long>(n);
     }
+    INSTRUMENT_PHASE("solve");
     min_distance_result<long long> result = min_distance_between_dots<long long>(dots);
     std::cout << result.a.x << ' ' << result.a.y << '\n';
     std::cout << result.b.x << ' ' << result.b.y << '\n';
@@ -116,6 +103,6 @@ void solveC() {
 
 int main() {
     std::ios_base::sync_with_stdio(false);
-    std::cin.tie(NULL);
     solveC();
+    return 0;
 }
\ No newline at end of file
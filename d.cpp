@@ -2,20 +2,8 @@
 #include <vector>
 #include <algorithm>
 
-template<typename T>
-class point {
-public:
-    T x;
-    T y;
-
-    point() = default;
-
-    point(T x, T y) : x(x), y(y) {}
-
-    bool operator==(const point &other) {
-        return x == other.x && y == other.y;
-    }
-};
+#include "geometry.h"
+#include "input.h"
 
 template<typename T>
 class segment {
@@ -99,18 +87,16 @@ bool is_inside_convex_polygon(point<T> point, std::vector<::point<T>> &polygon_v
 
 
 void solveD() {
-    int n, m, k;
-    std::cin >> n >> m >> k;
-    std::vector<point<long long>> polygon_vertices(n);
-    for (point<long long> &point : polygon_vertices) {
-        std::cin >> point.x >> point.y;
-    }
+    input_reader input;
+    int n = input.read<int>();
+    int m = input.read<int>();
+    int k = input.read<int>();
+    std::vector<point<long long>> polygon_vertices = input.read_points<long long>(n);
     std::reverse(polygon_vertices.begin(), polygon_vertices.end());
     set_left_point_to_head(polygon_vertices);
     int inside_count = 0;
     for (int i = 0; i < m; i++) {
-        point<long long> p{};
-        std::cin >> p.x >> p.y;
+        point<long long> p = input.read_point<long long>();
         inside_count += is_inside_convex_polygon(p, polygon_vertices);
     }
     if (inside_count >= k) {
@@ -119,3 +105,8 @@ void solveD() {
         std::cout << "NO\n";
     }
 }
+
+int main() {
+    solveD();
+    return 0;
+}
@@ -1,16 +1,8 @@
 #include <iostream>
 #include <vector>
 
-template<typename T>
-class point {
-public:
-    T x;
-    T y;
-
-    point() = default;
-
-    point(T x, T y) : x(x), y(y) {}
-};
+#include "geometry.h"
+#include "input.h"
 
 template<typename T>
 class segment {
@@ -33,21 +25,20 @@ public:
 
     segment(T x, T y) : x(x), y(y) {}
 
-    T operator*(const segment<T> &other) const {
-        return x * other.x + y * other.y;
+    typename wider<T>::type operator*(const segment<T> &other) const {
+        return dot(x, y, other.x, other.y);
     }
 
     segment<T> operator+(const segment<T> &other) const {
         return segment<T>(x + other.x, y + other.y);
     }
 
-    T operator&(const segment<T> &other) const {
-        return x * other.y - y * other.x;
+    typename wider<T>::type operator&(const segment<T> &other) const {
+        return cross(x, y, other.x, other.y);
     }
 
     int left_turn(point<T> point) const {
-        T cross_product = operator&(segment<T>(left, point));
-        return (cross_product > 0) - (cross_product < 0);
+        return sign(operator&(segment<T>(left, point)));
     }
 
     bool is_between_vertical_semi_interval(point<T> point) const {
@@ -117,19 +108,18 @@ bool is_in_polygon(point<T> point, std::vector<::point<T>> &polygon_vertices) {
 }
 
 void solveE() {
-    int polygon_vertices_count;
-    std::cin >> polygon_vertices_count;
-    int x, y;
-    std::cin >> x >> y;
-    point<int> point(x, y);
-    std::vector<::point<int>> polygon_vertices(polygon_vertices_count);
-    for (int i = 0; i < polygon_vertices_count; i++) {
-        std::cin >> x >> y;
-        polygon_vertices[i] = ::point<int>(x, y);
-    }
+    input_reader input;
+    int polygon_vertices_count = input.read<int>();
+    point<int> point = input.read_point<int>();
+    std::vector<::point<int>> polygon_vertices = input.read_points<int>(polygon_vertices_count);
     if (is_in_polygon(point, polygon_vertices)) {
         std::cout << "YES";
     } else {
         std::cout << "NO";
     }
 }
+
+int main() {
+    solveE();
+    return 0;
+}
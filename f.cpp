@@ -2,23 +2,11 @@
 #include <vector>
 #include <algorithm>
 #include <iomanip>
+#include <string>
 
-template<typename T>
-class point {
-public:
-    T x;
-    T y;
-
-    point() = default;
-
-    point(T x, T y) : x(x), y(y) {}
-};
-
-template<typename T>
-int left_turn(point<T> &s, point<T> from, point<T> to) {
-    T cross_product = (from.x - s.x) * (to.y - s.y) - (to.x - s.x) * (from.y - s.y);
-    return (cross_product > 0) - (cross_product < 0);
-}
+#include "geometry.h"
+#include "input.h"
+#include "output.h"
 
 template<typename T>
 void set_lowest_point_to_head(std::vector<point<T>> &points) {
@@ -50,23 +38,31 @@ std::vector<point<T>> convex_hull(std::vector<point<T>> &points) {
     return hull;
 }
 
-void print_square(long long square) {
-    std::cout << square / 2;
+void print_square(output_writer &out, long long square) {
+    if (out.is_binary()) {
+        out.write_fixed(square / 2.0L, 1);
+        return;
+    }
+    out.write_integer(square / 2);
     if (square % 2 == 1) {
-        std::cout << ".5";
+        out.write(".5");
     }
 }
 
-void solveF() {
-    int n;
-    std::cin >> n;
+void solveF(bool binary) {
     std::vector<point<long long>> points;
-    for (int i = 0; i < n; i++) {
-        int x, y;
-        std::cin >> x >> y;
-        points.emplace_back(x, y);
+    {
+        INSTRUMENT_PHASE("read");
+        input_reader input;
+        int n = input.read<int>();
+        points = input.read_points<long long>(n);
+    }
+    std::vector<point<long long>> hull;
+    {
+        INSTRUMENT_PHASE("hull");
+        hull = convex_hull(points);
     }
-    std::vector<point<long long>> hull = convex_hull(points);
+    INSTRUMENT_PHASE("output");
     long long square = 0;
     for (int i = 0; i < hull.size(); i++) {
         point<long long> a = hull[i];
@@ -74,15 +70,20 @@ void solveF() {
         square += (a.x * b.y - a.y * b.x);
     }
     std::reverse(hull.begin(), hull.end());
-    std::cout << hull.size() << '\n';
+    output_writer out(1, binary);
+    out.write_integer(hull.size());
+    out.write('\n');
     for (point<long long> point : hull) {
-        std::cout << point.x << ' ' << point.y << '\n';
+        out.write_integer(point.x);
+        out.write(' ');
+        out.write_integer(point.y);
+        out.write('\n');
     }
-    print_square(square);
+    print_square(out, square);
 }
 
-int main() {
-    std::ios_base::sync_with_stdio(false);
-    std::cin.tie(NULL);
-    solveF();
+// f [--binary]
+int main(int argc, char **argv) {
+    solveF(argc == 2 && std::string(argv[1]) == "--binary");
+    return 0;
 }
@@ -4,31 +4,11 @@
 #include <algorithm>
 #include <iomanip>
 #include <cassert>
+#include <numeric>
+#include <thread>
 
-
-template<typename T>
-class point {
-public:
-    T x;
-    T y;
-
-    point() = default;
-
-    point(T x, T y) : x(x), y(y) {}
-
-    friend std::istream &operator>>(std::istream &is, point<T> &p) {
-        is >> p.x >> p.y;
-        return is;
-    }
-
-    friend point<T> operator+(const point<T> &a, const point<T> &b) {
-        return {a.x + b.x, a.y + b.y};
-    }
-
-    friend point<T> operator-(const point<T> &a, const point<T> &b) {
-        return {a.x - b.x, a.y - b.y};
-    }
-};
+#include "geometry.h"
+#include "input.h"
 
 template<typename T>
 T min(T x, T y) {
@@ -54,14 +34,9 @@ T scalar_product(point<T> &a, point<T> &p, point<T> &q) {
     return (q.x - p.x) * (a.x - p.x) + (q.y - p.y) * (a.y - p.y);
 }
 
-template<typename T>
-T squared_distance(point<T> &a, point<T> &b) {
-    return (a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y);
-}
-
 template<typename T>
 long double distance(point<T> &a, point<T> &b) {
-    return std::sqrt(squared_distance(a, b));
+    return std::sqrt((long double) squared_distance(a, b));
 }
 
 template<typename T>
@@ -84,7 +59,7 @@ long double distance_to_segment(point<T> &a, point<T> &p, point<T> &q) {
 
 
 template<typename T>
-void set_lowest_point_to_head(std::vector<point<T>> &points) {
+int set_lowest_point_to_head(std::vector<point<T>> &points) {
     int position = 0;
     for (int i = 1; i < points.size(); i++) {
         if (points[i].x < points[position].x || (points[i].x == points[position].x && points[i].y < points[position].y)) {
@@ -94,21 +69,47 @@ void set_lowest_point_to_head(std::vector<point<T>> &points) {
     std::reverse(points.begin() + position, points.end());
     std::reverse(points.begin(), points.begin() + position);
     std::reverse(points.begin(), points.end());
+    return position;
 }
 
+// edge i of a polygon goes from vertex i to vertex i + 1, a vertex is covered by the edge starting at it
+class feature_pair {
+public:
+    int p_edge;
+    int q_edge;
+};
+
+// the distance from the origin to the Minkowski difference p - q, walked along its boundary;
+// 0 when the origin is inside it, that is when the polygons overlap
 template<typename T>
-long double polygons_distance(std::vector<point<T>> p, std::vector<point<T>> q) {
+long double polygons_distance(std::vector<point<T>> p, std::vector<point<T>> q, feature_pair &witness) {
     point<T> start = {0, 0};
-    set_lowest_point_to_head(p);
+    int p_size = p.size();
+    int q_size = q.size();
+    int p_shift = set_lowest_point_to_head(p);
     for (point<T> &vertex: q) {
         vertex.x *= -1;
         vertex.y *= -1;
     }
-    set_lowest_point_to_head(q);
+    int q_shift = set_lowest_point_to_head(q);
     p.push_back(p[0]);
     q.push_back(q[0]);
     point<T> cur = p[0] + q[0];
     long double distance = std::sqrt(cur.x * cur.x + cur.y * cur.y);
+    witness = {p_shift, q_shift};
+    // the origin is inside when it is on the same side of every edge
+    bool left_of_some = false;
+    bool right_of_some = false;
+    auto relax = [&](point<T> &prev, int left, int right) {
+        T side = cross_product(prev, cur, prev, start);
+        left_of_some |= side > 0;
+        right_of_some |= side < 0;
+        long double current = distance_to_segment(start, cur, prev);
+        if (current < distance) {
+            distance = current;
+            witness = {(left - 1 + p_shift) % p_size, (right - 1 + q_shift) % q_size};
+        }
+    };
     int left = 1;
     int right = 1;
     while (left < p.size() && right < q.size()) {
@@ -116,47 +117,247 @@ long double polygons_distance(std::vector<point<T>> p, std::vector<point<T>> q)
         point<T> prev = cur;
         if (turn >= 0) {
             cur = cur + p[left] - p[left - 1];
+            relax(prev, left, right);
             left++;
         } else {
             cur = cur + q[right] - q[right - 1];
+            relax(prev, left, right);
             right++;
         }
-        distance = min(distance, distance_to_segment(start, cur, prev));
     }
     while (left < p.size()) {
         point<T> prev = cur;
         cur = cur + p[left] - p[left - 1];
-        distance = min(distance, distance_to_segment(start, cur, prev));
+        relax(prev, left, right);
         left++;
     }
     while (right < q.size()) {
         point<T> prev = cur;
         cur = cur + q[right] - q[right - 1];
-        distance = min(distance, distance_to_segment(start, cur, prev));
+        relax(prev, left, right);
         right++;
     }
+    if (!left_of_some || !right_of_some) {
+        return 0;
+    }
     return distance;
 }
 
 template<typename T>
-std::vector<point<T>> read_polygon() {
-    int n;
-    std::cin >> n;
-    assert(n > 2);
-    std::vector<point<T>> polygon(n);
-    for (int i = 0; i < n; i++) {
-        std::cin >> polygon[i];
+long double polygons_distance(std::vector<point<T>> p, std::vector<point<T>> q) {
+    feature_pair witness{};
+    return polygons_distance(p, q, witness);
+}
+
+long double dot(point<long double> a, point<long double> b) {
+    return a.x * b.x + a.y * b.y;
+}
+
+point<long double> closest_on_segment(point<long double> a, point<long double> p, point<long double> q) {
+    point<long double> pq = q - p;
+    long double length = dot(pq, pq);
+    long double t = length == 0 ? 0 : std::max<long double>(0, std::min<long double>(1, dot(a - p, pq) / length));
+    return {p.x + pq.x * t, p.y + pq.y * t};
+}
+
+// closest points from and to of segments ab and cd
+long double segments_closest_points(point<long double> a, point<long double> b, point<long double> c,
+                                    point<long double> d, point<long double> &from, point<long double> &to) {
+    long double denominator = cross_product(a, b, c, d);
+    if (denominator != 0) {
+        long double t = cross_product(a, c, c, d) / denominator;
+        long double u = cross_product(a, c, a, b) / denominator;
+        if (0 <= t && t <= 1 && 0 <= u && u <= 1) {
+            from = to = {a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t};
+            return 0;
+        }
+    }
+    from = a;
+    to = closest_on_segment(a, c, d);
+    long double best = dot(to - from, to - from);
+    auto relax = [&](point<long double> x, point<long double> y) {
+        long double current = dot(y - x, y - x);
+        if (current < best) {
+            best = current;
+            from = x;
+            to = y;
+        }
+    };
+    relax(b, closest_on_segment(b, c, d));
+    relax(closest_on_segment(c, a, b), c);
+    relax(closest_on_segment(d, a, b), d);
+    return std::sqrt(best);
+}
+
+// warm-started polygons_distance for the same polygons moving between queries
+template<typename T>
+class polygons_distance_query {
+private:
+    feature_pair witness{-1, -1};
+    int p_size = 0;
+    int q_size = 0;
+    point<long double> from;
+    point<long double> to;
+
+    static point<long double> vertex(std::vector<point<T>> &polygon, int i) {
+        int n = polygon.size();
+        i = (i % n + n) % n;
+        return {(long double) polygon[i].x, (long double) polygon[i].y};
     }
+
+    long double edges_distance(std::vector<point<T>> &p, std::vector<point<T>> &q, feature_pair f) {
+        return segments_closest_points(vertex(p, f.p_edge), vertex(p, f.p_edge + 1),
+                                       vertex(q, f.q_edge), vertex(q, f.q_edge + 1), from, to);
+    }
+
+    // checks that the polygon lies behind the line through at orthogonal to direction,
+    // a vertex not beaten by its neighbours is extreme for a convex polygon
+    static bool is_supporting(std::vector<point<T>> &polygon, int edge, point<long double> at,
+                              point<long double> direction) {
+        long double first = dot(direction, vertex(polygon, edge));
+        long double second = dot(direction, vertex(polygon, edge + 1));
+        int extreme = first >= second ? edge : edge + 1;
+        long double top = std::max(first, second);
+        long double eps = 1e-12L * (std::abs(top) + 1);
+        return dot(direction, vertex(polygon, extreme - 1)) <= top + eps
+               && dot(direction, vertex(polygon, extreme + 1)) <= top + eps
+               && top <= dot(direction, at) + eps;
+    }
+
+public:
+    long double operator()(std::vector<point<T>> &p, std::vector<point<T>> &q) {
+        if (witness.p_edge == -1 || p_size != p.size() || q_size != q.size()) {
+            p_size = p.size();
+            q_size = q.size();
+            return polygons_distance(p, q, witness);
+        }
+        long double distance = edges_distance(p, q, witness);
+        for (int steps = 0; steps < p_size + q_size; steps++) {
+            feature_pair best = witness;
+            for (feature_pair next : {feature_pair{witness.p_edge + 1, witness.q_edge},
+                                      feature_pair{witness.p_edge - 1, witness.q_edge},
+                                      feature_pair{witness.p_edge, witness.q_edge + 1},
+                                      feature_pair{witness.p_edge, witness.q_edge - 1}}) {
+                next = {(next.p_edge + p_size) % p_size, (next.q_edge + q_size) % q_size};
+                long double current = edges_distance(p, q, next);
+                if (current < distance) {
+                    distance = current;
+                    best = next;
+                }
+            }
+            if (best.p_edge == witness.p_edge && best.q_edge == witness.q_edge) {
+                break;
+            }
+            witness = best;
+        }
+        edges_distance(p, q, witness);
+        point<long double> direction = to - from;
+        if (distance > 0 && is_supporting(p, witness.p_edge, from, direction)
+            && is_supporting(q, witness.q_edge, to, {-direction.x, -direction.y})) {
+            return distance;
+        }
+        return polygons_distance(p, q, witness);
+    }
+};
+
+template<typename T>
+class bounding_box {
+public:
+    T min_x;
+    T min_y;
+    T max_x;
+    T max_y;
+
+    explicit bounding_box(const std::vector<point<T>> &polygon) {
+        min_x = max_x = polygon[0].x;
+        min_y = max_y = polygon[0].y;
+        for (const point<T> &vertex : polygon) {
+            min_x = std::min(min_x, vertex.x);
+            min_y = std::min(min_y, vertex.y);
+            max_x = std::max(max_x, vertex.x);
+            max_y = std::max(max_y, vertex.y);
+        }
+    }
+
+    // lower bound for the distance between anything inside the boxes
+    long double squared_gap(const bounding_box<T> &other) const {
+        long double x = std::max<long double>(0, std::max(min_x - other.max_x, other.min_x - max_x));
+        long double y = std::max<long double>(0, std::max(min_y - other.max_y, other.min_y - max_y));
+        return x * x + y * y;
+    }
+};
+
+// sort and sweep over x-projections, pairs are returned as (smaller index, bigger index)
+template<typename T>
+std::vector<std::pair<int, int>> find_candidate_pairs(std::vector<bounding_box<T>> &boxes, long double r) {
+    std::vector<int> order(boxes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int a, int b) -> bool {
+        return boxes[a].min_x < boxes[b].min_x;
+    });
+    std::vector<std::pair<int, int>> candidates;
+    for (int i = 0; i < order.size(); i++) {
+        bounding_box<T> &box = boxes[order[i]];
+        for (int j = i + 1; j < order.size() && boxes[order[j]].min_x - box.max_x <= r; j++) {
+            if (box.squared_gap(boxes[order[j]]) <= r * r) {
+                candidates.emplace_back(std::min(order[i], order[j]), std::max(order[i], order[j]));
+            }
+        }
+    }
+    return candidates;
+}
+
+// all pairs of polygons within distance r, polygons are given in the same form as for polygons_distance
+template<typename T>
+std::vector<std::pair<int, int>> polygons_within_distance(std::vector<std::vector<point<T>>> &polygons, long double r,
+                                                          int threads_count = std::thread::hardware_concurrency()) {
+    std::vector<bounding_box<T>> boxes;
+    boxes.reserve(polygons.size());
+    for (std::vector<point<T>> &polygon : polygons) {
+        boxes.emplace_back(polygon);
+    }
+    std::vector<std::pair<int, int>> candidates = find_candidate_pairs(boxes, r);
+    threads_count = std::max(1, std::min<int>(threads_count, candidates.size()));
+    std::vector<std::vector<std::pair<int, int>>> found(threads_count);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threads_count; t++) {
+        threads.emplace_back([&, t]() {
+            for (int i = t; i < candidates.size(); i += threads_count) {
+                std::pair<int, int> candidate = candidates[i];
+                if (polygons_distance(polygons[candidate.first], polygons[candidate.second]) <= r) {
+                    found[t].push_back(candidate);
+                }
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    std::vector<std::pair<int, int>> result;
+    for (std::vector<std::pair<int, int>> &part : found) {
+        result.insert(result.end(), part.begin(), part.end());
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+template<typename T>
+std::vector<point<T>> read_polygon(input_reader &input) {
+    int n = input.read<int>();
+    assert(n > 2);
+    std::vector<point<T>> polygon = input.read_points<T>(n);
     std::reverse(polygon.begin(), polygon.end());
     return polygon;
 }
 
 void solveG() {
-    auto p = read_polygon<long long>();
-    auto q = read_polygon<long long>();
+    input_reader input;
+    auto p = read_polygon<long long>(input);
+    auto q = read_polygon<long long>(input);
     std::cout << std::fixed << std::setprecision(30) << polygons_distance(p, q);
 }
 
 int main() {
     solveG();
+    return 0;
 }
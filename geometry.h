@@ -0,0 +1,68 @@
+#ifndef GEOMETRY_CORE_H
+#define GEOMETRY_CORE_H
+
+#include <istream>
+#include <type_traits>
+
+#include "predicates.h"
+
+// shared by all the solutions, kept trivially copyable so vectors of points are plain memory
+template<typename T>
+class point {
+public:
+    T x;
+    T y;
+
+    point() = default;
+
+    constexpr point(T x, T y) noexcept : x(x), y(y) {}
+
+    constexpr bool operator==(const point<T> &other) const noexcept {
+        return x == other.x && y == other.y;
+    }
+
+    constexpr bool operator!=(const point<T> &other) const noexcept {
+        return !(*this == other);
+    }
+
+    constexpr bool operator<(const point<T> &other) const noexcept {
+        return x < other.x || (x == other.x && y < other.y);
+    }
+
+    friend constexpr point<T> operator+(const point<T> &a, const point<T> &b) noexcept {
+        return {a.x + b.x, a.y + b.y};
+    }
+
+    friend constexpr point<T> operator-(const point<T> &a, const point<T> &b) noexcept {
+        return {a.x - b.x, a.y - b.y};
+    }
+
+    friend std::istream &operator>>(std::istream &is, point<T> &p) {
+        is >> p.x >> p.y;
+        return is;
+    }
+};
+
+static_assert(std::is_trivially_copyable<point<int>>::value, "point<int> must be trivially copyable");
+static_assert(std::is_trivially_copyable<point<long long>>::value, "point<long long> must be trivially copyable");
+static_assert(std::is_trivially_copyable<point<long double>>::value, "point<long double> must be trivially copyable");
+
+// (p - s) x (q - s), positive when s -> p -> q turns left
+template<typename T>
+constexpr typename wider<T>::type cross_product(const point<T> &s, const point<T> &p, const point<T> &q) noexcept {
+    typedef typename wider<T>::type W;
+    return ((W) p.x - s.x) * ((W) q.y - s.y) - ((W) p.y - s.y) * ((W) q.x - s.x);
+}
+
+template<typename T>
+constexpr int left_turn(const point<T> &s, const point<T> &p, const point<T> &q) noexcept {
+    return orientation(s.x, s.y, p.x, p.y, q.x, q.y);
+}
+
+template<typename T>
+constexpr typename wider<T>::type squared_distance(const point<T> &a, const point<T> &b) noexcept {
+    typedef typename wider<T>::type W;
+    return ((W) a.x - b.x) * ((W) a.x - b.x) + ((W) a.y - b.y) * ((W) a.y - b.y);
+}
+
+#endif //GEOMETRY_CORE_H
@@ -1,29 +1,23 @@
 #include <iostream>
 #include <set>
+#include <queue>
 #include <vector>
 #include <algorithm>
+#include <iterator>
+#include <functional>
+#include <cstdint>
+#include <thread>
 
-template<typename T>
-class point {
-public:
-    T x;
-    T y;
-
-    point() = default;
-
-    point(T x, T y) : x(x), y(y) {}
-
-    bool operator==(const point<T> &other) const {
-        return x == other.x && y == other.y;
-    }
-};
+#include "geometry.h"
+#include "input.h"
 
 template<typename T>
 class segment {
 public:
 
-    T x;
-    T y;
+    // the direction, taken in the wide type so it does not overflow for any coordinates
+    typename wider<T>::type x;
+    typename wider<T>::type y;
     point<T> left;
     point<T> right;
 
@@ -33,8 +27,8 @@ public:
         if (left.x > right.x) {
             std::swap(left, right);
         }
-        x = right.x - left.x;
-        y = right.y - left.y;
+        x = (typename wider<T>::type) right.x - left.x;
+        y = (typename wider<T>::type) right.y - left.y;
     }
 
     segment(T x, T y) : x(x), y(y) {
@@ -45,21 +39,20 @@ public:
     segment() = default;
 
 
-    T operator*(const segment<T> &other) const {
-        return x * other.x + y * other.y;
+    typename wider<T>::type operator*(const segment<T> &other) const {
+        return dot(x, y, other.x, other.y);
     }
 
     segment<T> operator+(const segment<T> &other) const {
         return segment<T>(x + other.x, y + other.y);
     }
 
-    T operator&(const segment<T> &other) const {
-        return x * other.y - y * other.x;
+    typename wider<T>::type operator&(const segment<T> &other) const {
+        return cross(x, y, other.x, other.y);
     }
 
     int left_turn(point<T> point) const {
-        T cross_product = operator&(segment<T>(point.x - left.x, point.y - left.y));
-        return (cross_product > 0) - (cross_product < 0);
+        return orientation(left.x, left.y, right.x, right.y, point.x, point.y);
     }
 
     bool operator<(const segment<T> &other) const {
@@ -76,87 +69,414 @@ public:
 };
 
 
+// segments stored column-wise and addressed by 32-bit ids, endpoints are ordered by x as in segment
 template<typename T>
-class event {
-private:
-    int type;
+class segment_table {
 public:
-    segment<T> seg;
+    std::vector<T> left_x;
+    std::vector<T> left_y;
+    std::vector<T> right_x;
+    std::vector<T> right_y;
+
+    uint32_t add(point<T> a, point<T> b) {
+        if (a.x > b.x) {
+            std::swap(a, b);
+        }
+        left_x.push_back(a.x);
+        left_y.push_back(a.y);
+        right_x.push_back(b.x);
+        right_y.push_back(b.y);
+        return left_x.size() - 1;
+    }
 
-    explicit event(::segment<T> &segment, int type) : seg(segment), type(type) {
+    size_t size() const {
+        return left_x.size();
     }
 
-    bool operator<(const event<T> &other) const {
-        return (get_point().x < other.get_point().x) || (get_point().x == other.get_point().x
-                                                         && type < other.type);
+    segment<T> get(uint32_t id) const {
+        return segment<T>(point<T>(left_x[id], left_y[id]), point<T>(right_x[id], right_y[id]));
+    }
+
+    bool is_vertical(uint32_t id) const {
+        return left_x[id] == right_x[id];
+    }
+
+    int left_turn(uint32_t id, T x, T y) const {
+        return orientation(left_x[id], left_y[id], right_x[id], right_y[id], x, y);
     }
+};
+
+// segment::operator< over ids of a segment_table
+template<typename T>
+class segment_order {
+public:
+    const segment_table<T> *segments;
+
+    explicit segment_order(const segment_table<T> &segments) : segments(&segments) {}
 
-    point<T> get_point() const {
-        if (is_open()) {
-            return seg.left;
+    bool operator()(uint32_t a, uint32_t b) const {
+        const segment_table<T> &s = *segments;
+        if (s.is_vertical(a) && s.is_vertical(b)) {
+            return s.left_y[a] < s.left_y[b];
         }
-        return seg.right;
+        int turn = (s.left_x[a] < s.left_x[b] || s.is_vertical(b)) ? s.left_turn(a, s.left_x[b], s.left_y[b])
+                                                                    : -1 * s.left_turn(b, s.left_x[a], s.left_y[a]);
+        return turn > 0;
     }
+};
 
-    bool is_open() const {
-        return type == 0;
+// the type is the top bit of the id word, so an event takes 8 bytes for int and 16 for long long coordinates
+// and segment ids stay below 2^31
+template<typename T>
+class event {
+public:
+    T x;
+    uint32_t type_and_id;
+
+    event(T x, uint32_t id, int type) : x(x), type_and_id((uint32_t) type << 31 | id) {}
+
+    uint32_t id() const {
+        return type_and_id & 0x7fffffffu;
+    }
+
+    int type() const {
+        return type_and_id >> 31;
     }
 
+    bool operator<(const event<T> &other) const {
+        return x < other.x || (x == other.x && type() < other.type());
+    }
 
+    bool is_open() const {
+        return type() == 0;
+    }
 };
 
+static_assert(sizeof(event<int>) == 8, "an event of int coordinates must take 8 bytes");
+static_assert(sizeof(event<long long>) == 16, "an event of long long coordinates must take 16 bytes");
+
 template<typename T>
-event<T> close_event(segment<T> &segment) {
-    return event<T>(segment, 1);
+event<T> close_event(const segment_table<T> &segments, uint32_t id) {
+    return event<T>(segments.right_x[id], id, 1);
 }
 
 template<typename T>
-event<T> open_event(segment<T> &segment) {
-    return event<T>(segment, 0);
+event<T> open_event(const segment_table<T> &segments, uint32_t id) {
+    return event<T>(segments.left_x[id], id, 0);
 }
 
 template<typename T>
-class process_result {
+class sweep_input {
 public:
-    bool intersect;
-    segment<T> a;
-    segment<T> b;
+    segment_table<T> segments;
+    std::vector<event<T>> events;
 
-    process_result(segment<T> a, segment<T> b) : a(a), b(b) {
-        intersect = true;
+    void reserve(size_t size) {
+        segments.left_x.reserve(size);
+        segments.left_y.reserve(size);
+        segments.right_x.reserve(size);
+        segments.right_y.reserve(size);
+        events.reserve(2 * size);
     }
 
-    process_result() {
-        intersect = false;
+    // events are built while the input is read instead of in a separate pass
+    uint32_t add(point<T> a, point<T> b) {
+        uint32_t id = segments.add(a, b);
+        events.push_back(close_event(segments, id));
+        events.push_back(open_event(segments, id));
+        return id;
     }
 };
 
-template<typename T>
-process_result<T> process_open_segment(segment<T> &segment, std::set<::segment<T>> &open_segments) {
-    auto upper = open_segments.upper_bound(segment);
-    if (upper != open_segments.end() && is_intersect(segment, *upper)) {
-        return process_result<T>(segment, *upper);
+template<typename F>
+void parallel_for(int threads_count, F f) {
+    std::vector<std::thread> threads;
+    for (int t = 1; t < threads_count; t++) {
+        threads.emplace_back(f, t);
     }
-    if (upper != open_segments.begin() && is_intersect(segment, *(std::prev(upper)))) {
-        return process_result<T>(segment, *(std::prev(upper)));
+    f(0);
+    for (std::thread &thread : threads) {
+        thread.join();
     }
-    open_segments.insert(segment);
-    return process_result<T>();
 }
 
-template<typename T>
-process_result<T> process_close_segment(segment<T> &segment, std::set<::segment<T>> &open_segments) {
-    open_segments.erase(segment);
-    auto upper = open_segments.upper_bound(segment);
-    if (upper == open_segments.end() || upper == open_segments.begin()) {
-        return process_result<T>();
+// stable LSD radix sort by the bits from 31 up, the lower bits are left in arrival order
+inline void radix_sort_high_bits(std::vector<uint64_t> &keys, int threads_count) {
+    const int BITS = 11;
+    const int BUCKETS = 1 << BITS;
+    size_t n = keys.size();
+    std::vector<uint64_t> buffer(n);
+    std::vector<size_t> offsets(threads_count * BUCKETS);
+    for (int shift = 31; shift < 64; shift += BITS) {
+        std::fill(offsets.begin(), offsets.end(), 0);
+        parallel_for(threads_count, [&](int t) {
+            size_t *count = offsets.data() + t * BUCKETS;
+            for (size_t i = n * t / threads_count; i < n * (t + 1) / threads_count; i++) {
+                count[(keys[i] >> shift) & (BUCKETS - 1)]++;
+            }
+        });
+        size_t total = 0;
+        bool trivial = false;
+        for (int bucket = 0; bucket < BUCKETS; bucket++) {
+            size_t bucket_total = 0;
+            for (int t = 0; t < threads_count; t++) {
+                size_t count = offsets[t * BUCKETS + bucket];
+                offsets[t * BUCKETS + bucket] = total;
+                total += count;
+                bucket_total += count;
+            }
+            trivial |= bucket_total == n;
+        }
+        if (trivial) {
+            continue;
+        }
+        parallel_for(threads_count, [&](int t) {
+            size_t *offset = offsets.data() + t * BUCKETS;
+            for (size_t i = n * t / threads_count; i < n * (t + 1) / threads_count; i++) {
+                buffer[offset[(keys[i] >> shift) & (BUCKETS - 1)]++] = keys[i];
+            }
+        });
+        keys.swap(buffer);
     }
-    if (is_intersect(*upper, *std::prev(upper))) {
-        return process_result<T>(*upper, *std::prev(upper));
+}
+
+template<typename T>
+void sort_events(std::vector<event<T>> &events) {
+    std::sort(events.begin(), events.end());
+}
+
+// for 32-bit coordinates an event packs into biased x, type and id, so integer order is event order;
+// for fewer than 2^31 events
+inline void radix_sort_events(std::vector<event<int>> &events) {
+    size_t n = events.size();
+    int threads_count = std::max<int>(1, std::min<size_t>(std::thread::hardware_concurrency(), n >> 16));
+    std::vector<uint64_t> keys(n);
+    parallel_for(threads_count, [&](int t) {
+        for (size_t i = n * t / threads_count; i < n * (t + 1) / threads_count; i++) {
+            keys[i] = (uint64_t) ((uint32_t) events[i].x ^ 0x80000000u) << 32 | events[i].type_and_id;
+        }
+    });
+    radix_sort_high_bits(keys, threads_count);
+    parallel_for(threads_count, [&](int t) {
+        for (size_t i = n * t / threads_count; i < n * (t + 1) / threads_count; i++) {
+            events[i].x = (int) ((uint32_t) (keys[i] >> 32) ^ 0x80000000u);
+            events[i].type_and_id = (uint32_t) keys[i];
+        }
+    });
+}
+
+// below this std::sort wins, BM_sort_events puts the crossover between 2^11 and 2^12 events
+const size_t RADIX_SORT_THRESHOLD = 1 << 12;
+
+inline void sort_events(std::vector<event<int>> &events) {
+    if (events.size() < RADIX_SORT_THRESHOLD || events.size() >= (1u << 31)) {
+        std::sort(events.begin(), events.end());
+        return;
     }
-    return process_result<T>();
+    radix_sort_events(events);
 }
 
+// ordered set of unique keys for the sweep status: a two-level B+ tree whose leaves are fixed-size sorted
+// blocks taken from one pool, the first key of every leaf is copied into a contiguous index for the upper level
+template<typename K, typename Compare = std::less<K>>
+class block_set {
+private:
+    static const int BLOCK_SIZE = 64;
+
+    class block {
+    public:
+        int size;
+        K keys[BLOCK_SIZE];
+    };
+
+    std::vector<block> pool;
+    std::vector<int> free_blocks;
+    std::vector<int> blocks;
+    std::vector<K> firsts;
+    Compare less;
+    size_t count;
+
+    int allocate() {
+        if (free_blocks.empty()) {
+            pool.emplace_back();
+            return pool.size() - 1;
+        }
+        int index = free_blocks.back();
+        free_blocks.pop_back();
+        return index;
+    }
+
+    const block &get_block(int i) const {
+        return pool[blocks[i]];
+    }
+
+    block &get_block(int i) {
+        return pool[blocks[i]];
+    }
+
+public:
+    class iterator {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef K value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const K *pointer;
+        typedef const K &reference;
+
+        const block_set *set;
+        int block_index;
+        int position;
+
+        iterator(const block_set *set, int block_index, int position)
+                : set(set), block_index(block_index), position(position) {}
+
+        const K &operator*() const {
+            return set->get_block(block_index).keys[position];
+        }
+
+        const K *operator->() const {
+            return &set->get_block(block_index).keys[position];
+        }
+
+        iterator &operator++() {
+            if (++position == set->get_block(block_index).size) {
+                block_index++;
+                position = 0;
+            }
+            return *this;
+        }
+
+        iterator &operator--() {
+            if (position == 0) {
+                block_index--;
+                position = set->get_block(block_index).size;
+            }
+            position--;
+            return *this;
+        }
+
+        bool operator==(const iterator &other) const {
+            return block_index == other.block_index && position == other.position;
+        }
+
+        bool operator!=(const iterator &other) const {
+            return !(*this == other);
+        }
+    };
+
+    explicit block_set(Compare less = Compare()) : less(less), count(0) {}
+
+    size_t size() const {
+        return count;
+    }
+
+    iterator begin() const {
+        return iterator(this, 0, 0);
+    }
+
+    iterator end() const {
+        return iterator(this, blocks.size(), 0);
+    }
+
+    iterator lower_bound(const K &key) const {
+        int i = std::lower_bound(firsts.begin(), firsts.end(), key, less) - firsts.begin();
+        if (i == 0) {
+            return begin();
+        }
+        const block &b = get_block(i - 1);
+        int position = std::lower_bound(b.keys, b.keys + b.size, key, less) - b.keys;
+        return position == b.size ? iterator(this, i, 0) : iterator(this, i - 1, position);
+    }
+
+    iterator upper_bound(const K &key) const {
+        int i = std::upper_bound(firsts.begin(), firsts.end(), key, less) - firsts.begin();
+        if (i == 0) {
+            return begin();
+        }
+        const block &b = get_block(i - 1);
+        int position = std::upper_bound(b.keys, b.keys + b.size, key, less) - b.keys;
+        return position == b.size ? iterator(this, i, 0) : iterator(this, i - 1, position);
+    }
+
+    std::pair<iterator, bool> insert(const K &key) {
+        iterator it = lower_bound(key);
+        if (it != end() && !less(key, *it)) {
+            return {it, false};
+        }
+        if (blocks.empty()) {
+            blocks.push_back(allocate());
+            firsts.push_back(key);
+            get_block(0).size = 0;
+        }
+        int i = it.block_index;
+        int position = it.position;
+        if (i == blocks.size() || (position == 0 && i > 0)) {
+            // append to the end of the previous block rather than in front of the next one
+            i--;
+            position = get_block(i).size;
+        }
+        if (get_block(i).size == BLOCK_SIZE) {
+            int half = BLOCK_SIZE / 2;
+            int index = allocate();
+            block &b = get_block(i);
+            block &split = pool[index];
+            std::copy(b.keys + half, b.keys + BLOCK_SIZE, split.keys);
+            split.size = BLOCK_SIZE - half;
+            b.size = half;
+            blocks.insert(blocks.begin() + i + 1, index);
+            firsts.insert(firsts.begin() + i + 1, split.keys[0]);
+            if (position > half) {
+                i++;
+                position -= half;
+            }
+        }
+        block &b = get_block(i);
+        std::copy_backward(b.keys + position, b.keys + b.size, b.keys + b.size + 1);
+        b.keys[position] = key;
+        b.size++;
+        count++;
+        if (position == 0) {
+            firsts[i] = key;
+        }
+        return {iterator(this, i, position), true};
+    }
+
+    size_t erase(const K &key) {
+        iterator it = lower_bound(key);
+        if (it == end() || less(key, *it)) {
+            return 0;
+        }
+        int i = it.block_index;
+        block &b = get_block(i);
+        std::copy(b.keys + it.position + 1, b.keys + b.size, b.keys + it.position);
+        b.size--;
+        count--;
+        if (b.size == 0) {
+            free_blocks.push_back(blocks[i]);
+            blocks.erase(blocks.begin() + i);
+            firsts.erase(firsts.begin() + i);
+        } else if (it.position == 0) {
+            firsts[i] = b.keys[0];
+        }
+        return 1;
+    }
+};
+
+class process_result {
+public:
+    bool intersect;
+    uint32_t a;
+    uint32_t b;
+
+    process_result(uint32_t a, uint32_t b) : a(a), b(b) {
+        intersect = true;
+    }
+
+    process_result() {
+        intersect = false;
+    }
+};
+
 template<typename T>
 bool is_intersect(segment<T> a, segment<T> b) {
     return a.left_turn(b.left) * a.left_turn(b.right) <= 0
@@ -166,64 +486,414 @@ bool is_intersect(segment<T> a, segment<T> b) {
               std::min(std::max(a.left.y, a.right.y), std::max(b.left.y, b.right.y));
 }
 
-
 template<typename T>
-process_result<T> find_intersection(std::vector<segment<T>> segments) {
-    std::vector<event<T>> events;
-    for (segment<T> segment : segments) {
-        events.push_back(close_event(segment));
-        events.push_back(open_event(segment));
+bool is_intersect(const segment_table<T> &segments, uint32_t a, uint32_t b) {
+    return is_intersect(segments.get(a), segments.get(b));
+}
+
+template<typename T, typename Status>
+process_result process_open_segment(uint32_t id, const segment_table<T> &segments, Status &open_segments) {
+    auto upper = open_segments.upper_bound(id);
+    if (upper != open_segments.end() && is_intersect(segments, id, *upper)) {
+        return process_result(id, *upper);
     }
-    std::sort(events.begin(), events.end());
-    std::set<segment<T>> open_segments;
-    for (event<T> event : events) {
-        process_result<T> result = process_result<T>();
+    if (upper != open_segments.begin() && is_intersect(segments, id, *(std::prev(upper)))) {
+        return process_result(id, *(std::prev(upper)));
+    }
+    open_segments.insert(id);
+    return process_result();
+}
+
+template<typename T, typename Status>
+process_result process_close_segment(uint32_t id, const segment_table<T> &segments, Status &open_segments) {
+    open_segments.erase(id);
+    auto upper = open_segments.upper_bound(id);
+    if (upper == open_segments.end() || upper == open_segments.begin()) {
+        return process_result();
+    }
+    if (is_intersect(segments, *upper, *std::prev(upper))) {
+        return process_result(*upper, *std::prev(upper));
+    }
+    return process_result();
+}
+
+// Status is any ordered set of ids taking segment_order<T>: std::set works as well as the default block_set
+template<typename T, typename Status = block_set<uint32_t, segment_order<T>>>
+process_result sweep(const segment_table<T> &segments, const std::vector<event<T>> &events) {
+    Status open_segments{segment_order<T>(segments)};
+    for (const event<T> &event : events) {
+        process_result result = process_result();
         if (event.is_open()) {
-            result = process_open_segment(event.seg, open_segments);
+            result = process_open_segment(event.id(), segments, open_segments);
         } else {
-            result = process_close_segment(event.seg, open_segments);
+            result = process_close_segment(event.id(), segments, open_segments);
         }
+        INSTRUMENT_MAX("sweep.status_size", open_segments.size());
         if (result.intersect) {
             return result;
         }
     }
-    return process_result<T>();
+    return process_result();
 }
 
+template<typename T, typename Status = block_set<uint32_t, segment_order<T>>>
+process_result find_intersection(sweep_input<T> &input) {
+    {
+        INSTRUMENT_PHASE("sort");
+        sort_events(input.events);
+    }
+    INSTRUMENT_PHASE("sweep");
+    return sweep<T, Status>(input.segments, input.events);
+}
+
+template<typename T, typename Status = block_set<uint32_t, segment_order<T>>>
+process_result find_intersection(const segment_table<T> &segments) {
+    std::vector<event<T>> events;
+    events.reserve(2 * segments.size());
+    for (uint32_t id = 0; id < segments.size(); id++) {
+        events.push_back(close_event(segments, id));
+        events.push_back(open_event(segments, id));
+    }
+    {
+        INSTRUMENT_PHASE("sort");
+        sort_events(events);
+    }
+    INSTRUMENT_PHASE("sweep");
+    return sweep<T, Status>(segments, events);
+}
+
+// exact rational point (x / d, y / d) with d > 0. For int coordinates the numerators stay below 2^99 and d below
+// 2^66, and the products of the comparisons are taken in 256 bits
+class sweep_point {
+public:
+    __int128 x;
+    __int128 y;
+    __int128 d;
+
+    sweep_point() = default;
+
+    sweep_point(__int128 x, __int128 y, __int128 d) : x(x), y(y), d(d) {}
+
+    template<typename T>
+    explicit sweep_point(point<T> p) : x(p.x), y(p.y), d(1) {
+        static_assert(std::is_integral<T>::value && sizeof(T) <= sizeof(int),
+                      "sweep points are exact for coordinates of at most 32 bits");
+    }
+
+    bool operator<(const sweep_point &other) const {
+        int by_x = compare_products(x, other.d, other.x, d);
+        return by_x < 0 || (by_x == 0 && compare_products(y, other.d, other.y, d) < 0);
+    }
+
+    bool operator>(const sweep_point &other) const {
+        return other < *this;
+    }
+
+    bool operator==(const sweep_point &other) const {
+        return compare_products(x, other.d, other.x, d) == 0 && compare_products(y, other.d, other.y, d) == 0;
+    }
+
+    long double get_x() const {
+        return (long double) x / (long double) d;
+    }
+
+    long double get_y() const {
+        return (long double) y / (long double) d;
+    }
+};
+
+class intersection_report {
+public:
+    sweep_point point;
+    // indices of all segments passing through the point
+    std::vector<int> segments;
+};
+
+// order of the segments crossing the sweep line just after the current event point,
+// -1 and -2 are probes standing for the event point itself below and above all segments through it
 template<typename T>
-bool is_same(segment<T> a, segment<T> b) {
-    return a.left == b.left && a.right == b.right;
+class sweep_order {
+public:
+    const std::vector<segment<T>> *segments;
+    const sweep_point *current;
+
+    // sign of the segment height at the current x relative to the current point
+    int side(int id) const {
+        if (id < 0) {
+            return 0;
+        }
+        const segment<T> &s = (*segments)[id];
+        return -compare_products(s.x, current->y - (__int128) s.left.y * current->d,
+                                 s.y, current->x - (__int128) s.left.x * current->d);
+    }
+
+    bool less_direction(int a, int b) const {
+        if (a == b || a == -2 || b == -1) {
+            return false;
+        }
+        if (a == -1 || b == -2) {
+            return true;
+        }
+        const segment<T> &s = (*segments)[a];
+        const segment<T> &t = (*segments)[b];
+        if (s.is_vertical() || t.is_vertical()) {
+            return s.is_vertical() == t.is_vertical() ? a < b : t.is_vertical();
+        }
+        __int128 turn = (__int128) s.y * t.x - (__int128) t.y * s.x;
+        return turn < 0 || (turn == 0 && a < b);
+    }
+
+    bool operator()(int a, int b) const {
+        int side_a = side(a);
+        int side_b = side(b);
+        if (side_a != side_b) {
+            return side_a < side_b;
+        }
+        if (side_a == 0) {
+            return less_direction(a, b);
+        }
+        // the set only compares against a segment through the current point, two others never meet
+        return a < b;
+    }
+};
+
+template<typename T>
+bool find_intersection_point(const segment<T> &a, const segment<T> &b, sweep_point &result) {
+    __int128 denominator = (__int128) a.x * b.y - (__int128) a.y * b.x;
+    if (denominator == 0) {
+        // collinear overlaps are reported at the endpoint events inside the overlap
+        return false;
+    }
+    __int128 dx = (__int128) b.left.x - a.left.x;
+    __int128 dy = (__int128) b.left.y - a.left.y;
+    __int128 t = dx * b.y - dy * b.x;
+    __int128 u = dx * a.y - dy * a.x;
+    if (denominator < 0) {
+        denominator = -denominator;
+        t = -t;
+        u = -u;
+    }
+    if (t < 0 || t > denominator || u < 0 || u > denominator) {
+        return false;
+    }
+    result = sweep_point((__int128) a.left.x * denominator + t * a.x,
+                         (__int128) a.left.y * denominator + t * a.y, denominator);
+    return true;
 }
 
-void solveH() {
-    int n;
-    std::cin >> n;
-    std::vector<segment<int>> segments;
-    for (int i = 0; i < n; i++) {
-        int x, y;
-        std::cin >> x >> y;
-        point<int> p(x, y);
-        std::cin >> x >> y;
-        point<int> q(x, y);
-        segments.emplace_back(p, q);
-    }
-    auto result = find_intersection<int>(segments);
-    if (result.intersect) {
-        std::cout << "YES\n";
-        int i, j = 0;
-        for (int k = 0; k < segments.size(); k++) {
-            if (is_same(result.a, segments[k])) {
-                i = k;
-                break;
+// Bentley-Ottmann, reports every point shared by at least two segments in O((n + k) log n)
+template<typename T>
+std::vector<intersection_report> find_all_intersections(const segment_table<T> &input) {
+    std::vector<segment<T>> segments;
+    segments.reserve(input.size());
+    for (uint32_t id = 0; id < input.size(); id++) {
+        segment<T> s = input.get(id);
+        bool ordered = s.left.x < s.right.x || (s.left.x == s.right.x && s.left.y <= s.right.y);
+        segments.emplace_back(ordered ? s.left : s.right, ordered ? s.right : s.left);
+    }
+    std::vector<int> by_left(segments.size());
+    std::priority_queue<sweep_point, std::vector<sweep_point>, std::greater<sweep_point>> events;
+    for (int i = 0; i < segments.size(); i++) {
+        by_left[i] = i;
+        events.emplace(segments[i].left);
+        events.emplace(segments[i].right);
+    }
+    std::sort(by_left.begin(), by_left.end(), [&](int a, int b) -> bool {
+        return sweep_point(segments[a].left) < sweep_point(segments[b].left);
+    });
+    sweep_point current;
+    sweep_order<T> order{&segments, &current};
+    std::set<int, sweep_order<T>> status(order);
+    auto check = [&](int a, int b) {
+        sweep_point p;
+        if (find_intersection_point(segments[a], segments[b], p) && current < p) {
+            events.push(p);
+        }
+    };
+    std::vector<intersection_report> result;
+    int next_left = 0;
+    bool started = false;
+    while (!events.empty()) {
+        sweep_point p = events.top();
+        events.pop();
+        if (started && p == current) {
+            continue;
+        }
+        started = true;
+        current = p;
+        std::vector<int> starting;
+        while (next_left < by_left.size() && sweep_point(segments[by_left[next_left]].left) == current) {
+            starting.push_back(by_left[next_left++]);
+        }
+        auto first = status.lower_bound(-1);
+        auto last = status.upper_bound(-2);
+        std::vector<int> through(first, last);
+        status.erase(first, last);
+        if (through.size() + starting.size() >= 2) {
+            intersection_report report{current, through};
+            report.segments.insert(report.segments.end(), starting.begin(), starting.end());
+            std::sort(report.segments.begin(), report.segments.end());
+            result.push_back(report);
+        }
+        bool inserted = false;
+        for (std::vector<int> *group : {&through, &starting}) {
+            for (int id : *group) {
+                if (!(sweep_point(segments[id].right) == current)) {
+                    status.insert(id);
+                    inserted = true;
+                }
+            }
+        }
+        auto lower = status.lower_bound(-1);
+        if (!inserted) {
+            if (lower != status.begin() && lower != status.end()) {
+                check(*std::prev(lower), *lower);
             }
+            continue;
         }
-        for (int k = 0; k < segments.size(); k++) {
-            if (is_same(result.b, segments[k]) && i != k) {
-                j = k;
+        auto upper = status.upper_bound(-2);
+        if (lower != status.begin()) {
+            check(*std::prev(lower), *lower);
+        }
+        if (upper != status.end()) {
+            check(*std::prev(upper), *upper);
+        }
+    }
+    return result;
+}
+
+class different_layers {
+public:
+    uint32_t first_blue;
+
+    bool operator()(uint32_t a, uint32_t b) const {
+        return (a < first_blue) != (b < first_blue);
+    }
+};
+
+// red-blue detection: result.a is a red id and result.b a blue id. Crossings inside one layer are swept over as
+// in find_all_intersections, as events that keep the status in order without being tested or reported, so the
+// layers may cross themselves freely. Detection between two arbitrary layers is as hard as Hopcroft's problem,
+// and this takes O((n + k) log n) with k the intra-layer crossings met before the first bichromatic one
+template<typename T>
+process_result find_bichromatic_intersection(const segment_table<T> &red, const segment_table<T> &blue) {
+    std::vector<segment<T>> segments;
+    segments.reserve(red.size() + blue.size());
+    for (const segment_table<T> *layer : {&red, &blue}) {
+        for (uint32_t id = 0; id < layer->size(); id++) {
+            segment<T> s = layer->get(id);
+            bool ordered = s.left.x < s.right.x || (s.left.x == s.right.x && s.left.y <= s.right.y);
+            segments.emplace_back(ordered ? s.left : s.right, ordered ? s.right : s.left);
+        }
+    }
+    different_layers colours{(uint32_t) red.size()};
+    std::vector<int> by_left(segments.size());
+    std::priority_queue<sweep_point, std::vector<sweep_point>, std::greater<sweep_point>> events;
+    for (int i = 0; i < segments.size(); i++) {
+        by_left[i] = i;
+        events.emplace(segments[i].left);
+        events.emplace(segments[i].right);
+    }
+    std::sort(by_left.begin(), by_left.end(), [&](int a, int b) -> bool {
+        return sweep_point(segments[a].left) < sweep_point(segments[b].left);
+    });
+    sweep_point current;
+    sweep_order<T> order{&segments, &current};
+    std::set<int, sweep_order<T>> status(order);
+    process_result result = process_result();
+    // neighbours of different layers are tested, neighbours of one layer only schedule their crossing
+    auto check = [&](int a, int b) {
+        if (result.intersect) {
+            return;
+        }
+        if (colours(a, b)) {
+            if (is_intersect(segments[a], segments[b])) {
+                result = process_result(a, b);
+            }
+            return;
+        }
+        sweep_point p;
+        if (find_intersection_point(segments[a], segments[b], p) && current < p) {
+            events.push(p);
+        }
+    };
+    int next_left = 0;
+    bool started = false;
+    while (!result.intersect && !events.empty()) {
+        sweep_point p = events.top();
+        events.pop();
+        if (started && p == current) {
+            continue;
+        }
+        started = true;
+        current = p;
+        std::vector<int> touching;
+        while (next_left < by_left.size() && sweep_point(segments[by_left[next_left]].left) == current) {
+            touching.push_back(by_left[next_left++]);
+        }
+        auto first = status.lower_bound(-1);
+        auto last = status.upper_bound(-2);
+        touching.insert(touching.end(), first, last);
+        status.erase(first, last);
+        // everything here shares the current point
+        for (int id : touching) {
+            if (colours(touching[0], id)) {
+                result = process_result(touching[0], id);
                 break;
             }
         }
-        std::cout << i + 1 << ' ' << j + 1 << '\n';
+        if (result.intersect) {
+            break;
+        }
+        bool inserted = false;
+        for (int id : touching) {
+            if (!(sweep_point(segments[id].right) == current)) {
+                status.insert(id);
+                inserted = true;
+            }
+        }
+        auto lower = status.lower_bound(-1);
+        if (!inserted) {
+            if (lower != status.begin() && lower != status.end()) {
+                check(*std::prev(lower), *lower);
+            }
+            continue;
+        }
+        auto upper = status.upper_bound(-2);
+        if (lower != status.begin()) {
+            check(*std::prev(lower), *lower);
+        }
+        if (upper != status.end()) {
+            check(*std::prev(upper), *upper);
+        }
+    }
+    if (result.intersect) {
+        if (result.a >= colours.first_blue) {
+            std::swap(result.a, result.b);
+        }
+        result.b -= colours.first_blue;
+    }
+    return result;
+}
+
+void solveH() {
+    sweep_input<int> input;
+    {
+        INSTRUMENT_PHASE("read");
+        input_reader reader;
+        int n = reader.read<int>();
+        input.reserve(n);
+        for (int i = 0; i < n; i++) {
+            point<int> p = reader.read_point<int>();
+            point<int> q = reader.read_point<int>();
+            input.add(p, q);
+        }
+    }
+    auto result = find_intersection(input);
+    INSTRUMENT_PHASE("output");
+    if (result.intersect) {
+        std::cout << "YES\n";
+        std::cout << result.a + 1 << ' ' << result.b + 1 << '\n';
     } else {
         std::cout << "NO\n";
     }
@@ -231,4 +901,5 @@ void solveH() {
 
 int main() {
     solveH();
+    return 0;
 }
@@ -1,37 +1,116 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <set>
+#include <fstream>
+#include <cstdint>
+#include <string>
+#include <atomic>
+#include <thread>
+
+#include "geometry.h"
+#include "input.h"
+#include "output.h"
 
 template<typename T>
-class point {
+bool is_in_triangle(point<T> a, point<T> left, point<T> middle, point<T> right) {
+    return (left_turn(left, middle, a) * left_turn(left, right, a) <= 0)
+           && (left_turn(middle, left, a) * left_turn(middle, right, a) <= 0)
+           && (left_turn(right, left, a) * left_turn(right, middle, a) <= 0);
+}
+
+// vertices of the remaining polygon that are not strictly convex, bucketed into a uniform grid
+// over the bounding box so an ear only has to be checked against the ones near it
+template<typename T>
+class reflex_grid {
 public:
-    T x;
-    T y;
+    std::vector<point<T>> *polygon;
+    T min_x;
+    T min_y;
+    long double scale_x;
+    long double scale_y;
+    int side;
+    std::vector<std::vector<int>> cells;
+    std::vector<int> cell_of;
+    std::vector<int> position;
+
+    reflex_grid(std::vector<point<T>> &polygon, std::vector<int> &reflex)
+            : polygon(&polygon), cell_of(polygon.size(), -1), position(polygon.size(), -1) {
+        min_x = max_x(polygon, -1);
+        min_y = max_y(polygon, -1);
+        side = 1;
+        while ((long long) side * side < (long long) reflex.size()) {
+            side++;
+        }
+        scale_x = side / ((long double) max_x(polygon, 1) - min_x + 1);
+        scale_y = side / ((long double) max_y(polygon, 1) - min_y + 1);
+        cells.resize(side * side);
+        for (int v : reflex) {
+            int cell = row(polygon[v].y) * side + column(polygon[v].x);
+            cell_of[v] = cell;
+            position[v] = cells[cell].size();
+            cells[cell].push_back(v);
+        }
+    }
 
-    point() = default;
+    static T max_x(std::vector<point<T>> &polygon, int sign) {
+        T result = polygon[0].x;
+        for (point<T> &p : polygon) {
+            result = sign * p.x > sign * result ? p.x : result;
+        }
+        return result;
+    }
 
-    point(T x, T y) : x(x), y(y) {}
+    static T max_y(std::vector<point<T>> &polygon, int sign) {
+        T result = polygon[0].y;
+        for (point<T> &p : polygon) {
+            result = sign * p.y > sign * result ? p.y : result;
+        }
+        return result;
+    }
 
-    bool operator==(const point<T> &other) const {
-        return x == other.x && y == other.y;
+    int column(T x) const {
+        return std::min(side - 1, (int) ((x - min_x) * scale_x));
     }
-};
 
-template<typename T>
-int left_turn(point<T> s, point<T> p, point<T> q) {
-    int turn = (p.x - s.x) * (q.y - s.y) - (p.y - s.y) * (q.x - s.x);
-    return (turn > 0) - (turn < 0);
-}
+    int row(T y) const {
+        return std::min(side - 1, (int) ((y - min_y) * scale_y));
+    }
 
-template<typename T>
-bool is_in_triangle(point<T> a, point<T> left, point<T> middle, point<T> right) {
-    return (left_turn(left, middle, a) * left_turn(left, right, a) <= 0)
-           && (left_turn(middle, left, a) * left_turn(middle, right, a) <= 0)
-           && (left_turn(right, left, a) * left_turn(right, middle, a) <= 0);
-}
+    void erase(int v) {
+        int cell = cell_of[v];
+        if (cell == -1) {
+            return;
+        }
+        int last = cells[cell].back();
+        cells[cell][position[v]] = last;
+        position[last] = position[v];
+        cells[cell].pop_back();
+        cell_of[v] = -1;
+    }
+
+    bool has_point_in_triangle(int left, int middle, int right) const {
+        std::vector<point<T>> &p = *polygon;
+        int first_column = column(std::min({p[left].x, p[middle].x, p[right].x}));
+        int last_column = column(std::max({p[left].x, p[middle].x, p[right].x}));
+        int first_row = row(std::min({p[left].y, p[middle].y, p[right].y}));
+        int last_row = row(std::max({p[left].y, p[middle].y, p[right].y}));
+        for (int r = first_row; r <= last_row; r++) {
+            for (int c = first_column; c <= last_column; c++) {
+                for (int v : cells[r * side + c]) {
+                    if (v != left && v != middle && v != right
+                        && is_in_triangle(p[v], p[left], p[middle], p[right])) {
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+};
 
 template<typename T>
-bool has_ear(std::vector<int> &stack, std::vector<point<T>> &polygon, std::vector<int> &used) {
+bool has_ear(std::vector<int> &stack, std::vector<point<T>> &polygon, reflex_grid<T> &grid) {
     int size = stack.size();
     if (size < 3) {
         return false;
@@ -39,70 +118,669 @@ bool has_ear(std::vector<int> &stack, std::vector<point<T>> &polygon, std::vecto
     int left = stack[size - 3];
     int middle = stack[size - 2];
     int right = stack[size - 1];
-    if (left_turn(polygon[left], polygon[middle], polygon[right]) > 0) {
-        for (int i = 0; i < polygon.size(); i++) {
-            if (i != left && i != right && i != middle && !used[i] &&
-                is_in_triangle(polygon[i], polygon[left], polygon[middle], polygon[right])) {
-                return false;
-            }
-        }
-        return true;
-    }
-    return false;
+    return left_turn(polygon[left], polygon[middle], polygon[right]) > 0
+           && !grid.has_point_in_triangle(left, middle, right);
 }
 
 template<typename T>
-std::vector<std::pair<int, int>> triangulate(std::vector<point<T>> &polygon) {
+std::vector<std::pair<int, int>> triangulate_by_ears(std::vector<point<T>> &polygon) {
+    int n = polygon.size();
     std::vector<std::pair<int, int>> diagonals;
-    std::vector<int> used(polygon.size(), 0);
+    std::vector<int> prev(n);
+    std::vector<int> next(n);
+    std::vector<int> reflex;
+    for (int i = 0; i < n; i++) {
+        prev[i] = (i + n - 1) % n;
+        next[i] = (i + 1) % n;
+        if (left_turn(polygon[prev[i]], polygon[i], polygon[next[i]]) <= 0) {
+            reflex.push_back(i);
+        }
+    }
+    reflex_grid<T> grid(polygon, reflex);
+    // cutting an ear can only make its neighbours convex, never reflex
+    auto update = [&](int v) {
+        if (left_turn(polygon[prev[v]], polygon[v], polygon[next[v]]) > 0) {
+            grid.erase(v);
+        }
+    };
     std::vector<int> stack;
-    for (int i = 0; i < polygon.size(); i++) {
+    for (int i = 0; i < n; i++) {
         stack.push_back(i);
-        while (diagonals.size() != polygon.size() - 3 && has_ear(stack, polygon, used)) {
+        while ((int) diagonals.size() != n - 3 && has_ear(stack, polygon, grid)) {
             int size = stack.size();
-            diagonals.emplace_back(stack[size - 3], stack[size - 1]);
-            std::swap(stack[size - 1], stack[size - 2]);
-            used[stack[size - 1]] = 1;
+            int left = stack[size - 3];
+            int right = stack[size - 1];
+            diagonals.emplace_back(left, right);
+            next[left] = right;
+            prev[right] = left;
+            update(left);
+            update(right);
+            stack[size - 2] = right;
+            stack.pop_back();
+        }
+    }
+    return diagonals;
+}
+
+// sweep order from top to bottom, ties are broken by x as if the plane were slightly rotated
+template<typename T>
+bool is_above(const point<T> &a, const point<T> &b) {
+    return a.y > b.y || (a.y == b.y && a.x < b.x);
+}
+
+enum vertex_type {
+    start_vertex,
+    end_vertex,
+    split_vertex,
+    merge_vertex,
+    regular_vertex
+};
+
+template<typename T>
+vertex_type classify(std::vector<point<T>> &polygon, int i) {
+    int n = polygon.size();
+    point<T> &prev = polygon[(i + n - 1) % n];
+    point<T> &next = polygon[(i + 1) % n];
+    bool convex = left_turn(prev, polygon[i], next) >= 0;
+    if (is_above(polygon[i], prev) && is_above(polygon[i], next)) {
+        return convex ? start_vertex : split_vertex;
+    }
+    if (is_above(prev, polygon[i]) && is_above(next, polygon[i])) {
+        return convex ? end_vertex : merge_vertex;
+    }
+    return regular_vertex;
+}
+
+// edges i -> i + 1 of a counter-clockwise polygon going down with the interior on their right,
+// ordered left to right at the current vertex, -1 stands for the current vertex itself
+template<typename T>
+class edge_order {
+public:
+    const std::vector<point<T>> *polygon;
+    const int *current;
+
+    int side(int edge) const {
+        if (edge == -1 || edge == *current) {
+            return 0;
+        }
+        const std::vector<point<T>> &p = *polygon;
+        int turn = left_turn(p[edge], p[(edge + 1) % p.size()], p[*current]);
+        return turn > 0 ? -1 : 1;
+    }
+
+    bool operator()(int a, int b) const {
+        int side_a = side(a);
+        int side_b = side(b);
+        return side_a < side_b || (side_a == side_b && a < b);
+    }
+};
+
+// diagonals splitting a counter-clockwise polygon into y-monotone pieces. False when the sweep meets a vertex
+// with no edge to its left or closes an edge that is not open, which only happens if the polygon is not simple
+template<typename T>
+bool monotone_partition(std::vector<point<T>> &polygon, std::vector<std::pair<int, int>> &diagonals) {
+    int n = polygon.size();
+    std::vector<int> order(n);
+    std::vector<vertex_type> types(n);
+    for (int i = 0; i < n; i++) {
+        order[i] = i;
+        types[i] = classify(polygon, i);
+    }
+    std::sort(order.begin(), order.end(), [&](int a, int b) -> bool {
+        return is_above(polygon[a], polygon[b]);
+    });
+    int current = 0;
+    edge_order<T> less{&polygon, &current};
+    std::set<int, edge_order<T>> status(less);
+    std::vector<typename std::set<int, edge_order<T>>::iterator> handles(n, status.end());
+    std::vector<int> helper(n);
+    auto connect_merge_helper = [&](int edge) {
+        if (types[helper[edge]] == merge_vertex) {
+            diagonals.emplace_back(current, helper[edge]);
+        }
+    };
+    auto insert = [&](int edge) {
+        handles[edge] = status.insert(edge).first;
+        helper[edge] = current;
+    };
+    auto erase = [&](int edge) {
+        if (handles[edge] == status.end()) {
+            return false;
+        }
+        connect_merge_helper(edge);
+        status.erase(handles[edge]);
+        handles[edge] = status.end();
+        return true;
+    };
+    auto left_edge = [&](int &edge) {
+        auto right = status.lower_bound(-1);
+        if (right == status.begin()) {
+            return false;
+        }
+        edge = *std::prev(right);
+        return true;
+    };
+    for (int i : order) {
+        current = i;
+        int prev = (i + n - 1) % n;
+        int left;
+        if (types[i] == start_vertex) {
+            insert(i);
+        } else if (types[i] == end_vertex) {
+            if (!erase(prev)) {
+                return false;
+            }
+        } else if (types[i] == split_vertex) {
+            if (!left_edge(left)) {
+                return false;
+            }
+            diagonals.emplace_back(i, helper[left]);
+            helper[left] = i;
+            insert(i);
+        } else if (types[i] == merge_vertex) {
+            if (!erase(prev) || !left_edge(left)) {
+                return false;
+            }
+            connect_merge_helper(left);
+            helper[left] = i;
+        } else if (is_above(polygon[prev], polygon[i])) {
+            if (!erase(prev)) {
+                return false;
+            }
+            insert(i);
+        } else {
+            if (!left_edge(left)) {
+                return false;
+            }
+            connect_merge_helper(left);
+            helper[left] = i;
+        }
+    }
+    return true;
+}
+
+// counter-clockwise angular order of directions around the origin starting from the positive x axis
+template<typename T>
+bool is_before_by_angle(point<T> a, point<T> b) {
+    bool a_lower = a.y < 0 || (a.y == 0 && a.x < 0);
+    bool b_lower = b.y < 0 || (b.y == 0 && b.x < 0);
+    if (a_lower != b_lower) {
+        return b_lower;
+    }
+    return left_turn(point<T>(0, 0), a, b) > 0;
+}
+
+// polygon border and diagonals as half-edges: the edges leaving a vertex are sorted counter-clockwise
+// in neighbours[offsets[v]..offsets[v + 1]), twins[e] is the reverse of e, and faces[e] is the face
+// to the left of e or -1 outside the polygon. The buffers are reused between builds
+class diagonal_graph {
+public:
+    std::vector<int> offsets;
+    std::vector<int> neighbours;
+    std::vector<int> twins;
+    std::vector<int> faces;
+    // the slot every edge was filled into, then where that slot went when the edges were sorted
+    std::vector<int> order;
+    std::vector<int> moved;
+
+    template<typename T>
+    void build(std::vector<point<T>> &polygon, std::vector<std::pair<int, int>> &diagonals) {
+        int n = polygon.size();
+        offsets.assign(n + 1, 0);
+        for (int i = 0; i < n; i++) {
+            offsets[i + 1] = 2;
+        }
+        for (auto diagonal : diagonals) {
+            offsets[diagonal.first + 1]++;
+            offsets[diagonal.second + 1]++;
+        }
+        for (int i = 0; i < n; i++) {
+            offsets[i + 1] += offsets[i];
+        }
+        int edges = offsets[n];
+        neighbours.resize(edges);
+        twins.resize(edges);
+        faces.resize(edges);
+        order.resize(edges);
+        moved.resize(edges);
+        // both halves of an edge are filled together, so the twins are known without a search
+        for (int i = 0; i < n; i++) {
+            int next = (i + 1) % n;
+            neighbours[offsets[i] + 1] = next;
+            neighbours[offsets[next]] = i;
+            twins[offsets[i] + 1] = offsets[next];
+            twins[offsets[next]] = offsets[i] + 1;
+        }
+        std::vector<int> filled(offsets.begin(), offsets.end() - 1);
+        for (int i = 0; i < n; i++) {
+            filled[i] += 2;
+        }
+        for (auto diagonal : diagonals) {
+            int a = filled[diagonal.first]++;
+            int b = filled[diagonal.second]++;
+            neighbours[a] = diagonal.second;
+            neighbours[b] = diagonal.first;
+            twins[a] = b;
+            twins[b] = a;
+        }
+        for (int e = 0; e < edges; e++) {
+            order[e] = e;
+        }
+        for (int i = 0; i < n; i++) {
+            if (offsets[i + 1] - offsets[i] > 2) {
+                std::sort(order.begin() + offsets[i], order.begin() + offsets[i + 1], [&](int a, int b) {
+                    const point<T> &p = polygon[neighbours[a]];
+                    const point<T> &q = polygon[neighbours[b]];
+                    return is_before_by_angle(point<T>(p.x - polygon[i].x, p.y - polygon[i].y),
+                                              point<T>(q.x - polygon[i].x, q.y - polygon[i].y));
+                });
+            }
+        }
+        for (int e = 0; e < edges; e++) {
+            moved[order[e]] = e;
+        }
+        // faces takes the sorted neighbours for a moment, the twins follow their slots
+        for (int e = 0; e < edges; e++) {
+            faces[e] = neighbours[order[e]];
+            order[e] = moved[twins[order[e]]];
+        }
+        neighbours.swap(faces);
+        twins.swap(order);
+        for (int i = 0; i < n; i++) {
+            for (int e = offsets[i]; e < offsets[i + 1]; e++) {
+                // edges going clockwise along the border lie outside
+                faces[e] = neighbours[e] == (i + n - 1) % n ? -1 : -2;
+            }
+        }
+    }
+
+    // the edge following e around the face to its left
+    int next(int e) const {
+        int to = neighbours[e];
+        return twins[e] == offsets[to] ? offsets[to + 1] - 1 : twins[e] - 1;
+    }
+
+    int origin(int e) const {
+        return neighbours[twins[e]];
+    }
+
+    // numbers the faces inside the polygon and calls visit(face, corner, e) for their edges in order
+    template<typename F>
+    int walk_faces(F visit) {
+        int count = 0;
+        for (int start = 0; start < (int) faces.size(); start++) {
+            if (faces[start] != -2) {
+                continue;
+            }
+            int corner = 0;
+            for (int e = start; faces[e] == -2; e = next(e)) {
+                faces[e] = count;
+                visit(count, corner++, e);
+            }
+            count++;
+        }
+        return count;
+    }
+};
+
+// counter-clockwise vertex cycles of the pieces the diagonals cut the polygon into
+template<typename T>
+std::vector<std::vector<int>> split_by_diagonals(std::vector<point<T>> &polygon,
+                                                 std::vector<std::pair<int, int>> &diagonals,
+                                                 diagonal_graph &graph) {
+    graph.build(polygon, diagonals);
+    std::vector<std::vector<int>> pieces;
+    graph.walk_faces([&](int face, int corner, int e) {
+        if (corner == 0) {
+            pieces.emplace_back();
+        }
+        pieces[face].push_back(graph.origin(e));
+    });
+    return pieces;
+}
+
+// linear stack triangulation of a counter-clockwise y-monotone piece given by polygon indices
+template<typename T>
+void triangulate_monotone(std::vector<point<T>> &polygon, std::vector<int> &piece,
+                          std::vector<std::pair<int, int>> &diagonals) {
+    int m = piece.size();
+    if (m <= 3) {
+        return;
+    }
+    int top = 0;
+    int bottom = 0;
+    for (int i = 1; i < m; i++) {
+        if (is_above(polygon[piece[i]], polygon[piece[top]])) {
+            top = i;
+        }
+        if (is_above(polygon[piece[bottom]], polygon[piece[i]])) {
+            bottom = i;
+        }
+    }
+    // merge the left chain going down from the top with the right chain going up to it
+    std::vector<std::pair<int, bool>> sorted;
+    sorted.reserve(m);
+    int left = top;
+    int right = (top + m - 1) % m;
+    sorted.emplace_back(piece[top], true);
+    left = (left + 1) % m;
+    while ((int) sorted.size() < m) {
+        if (left != (bottom + 1) % m
+            && (right == bottom || is_above(polygon[piece[left]], polygon[piece[right]]))) {
+            sorted.emplace_back(piece[left], true);
+            left = (left + 1) % m;
+        } else {
+            sorted.emplace_back(piece[right], false);
+            right = (right + m - 1) % m;
+        }
+    }
+    std::vector<std::pair<int, bool>> stack = {sorted[0], sorted[1]};
+    for (int j = 2; j + 1 < m; j++) {
+        std::pair<int, bool> u = sorted[j];
+        if (u.second != stack.back().second) {
+            for (int k = stack.size() - 1; k > 0; k--) {
+                diagonals.emplace_back(u.first, stack[k].first);
+            }
+            stack = {sorted[j - 1], u};
+        } else {
+            std::pair<int, bool> last = stack.back();
             stack.pop_back();
+            while (!stack.empty()) {
+                point<T> &s = polygon[stack.back().first];
+                point<T> &l = polygon[last.first];
+                point<T> &v = polygon[u.first];
+                if ((u.second ? left_turn(s, l, v) : left_turn(v, l, s)) <= 0) {
+                    break;
+                }
+                last = stack.back();
+                stack.pop_back();
+                diagonals.emplace_back(u.first, last.first);
+            }
+            stack.push_back(last);
+            stack.push_back(u);
+        }
+    }
+    for (int k = stack.size() - 2; k > 0; k--) {
+        diagonals.emplace_back(sorted[m - 1].first, stack[k].first);
+    }
+}
+
+// drops every vertex equal to the one before it, a closing copy of the first vertex included, and returns the
+// input index of each vertex kept. The partition needs consecutive vertices to be distinct
+template<typename T>
+std::vector<int> remove_repeated_vertices(std::vector<point<T>> &polygon) {
+    std::vector<int> original;
+    int size = 0;
+    for (int i = 0; i < polygon.size(); i++) {
+        if (size == 0 || polygon[i] != polygon[size - 1]) {
+            polygon[size++] = polygon[i];
+            original.push_back(i);
         }
     }
+    while (size > 1 && polygon[size - 1] == polygon[0]) {
+        size--;
+        original.pop_back();
+    }
+    polygon.resize(size);
+    return original;
+}
+
+// O(n log n): monotone partition, then every piece in linear time. The polygon is counter-clockwise with
+// distinct consecutive vertices, see remove_repeated_vertices. If it is not simple the diagonals mean nothing,
+// and none come back when the sweep notices
+template<typename T>
+std::vector<std::pair<int, int>> triangulate(std::vector<point<T>> &polygon, diagonal_graph &graph) {
+    std::vector<std::pair<int, int>> diagonals;
+    if (!monotone_partition(polygon, diagonals)) {
+        return {};
+    }
+    std::vector<std::vector<int>> pieces = split_by_diagonals(polygon, diagonals, graph);
+    for (std::vector<int> &piece : pieces) {
+        triangulate_monotone(polygon, piece, diagonals);
+    }
     return diagonals;
 }
 
+template<typename T>
+std::vector<std::pair<int, int>> triangulate(std::vector<point<T>> &polygon) {
+    diagonal_graph graph;
+    return triangulate(polygon, graph);
+}
+
+// the monotone partition, or with ears the grid-backed ear clipper: quadratic at worst but without a sweep,
+// and near-linear when the reflex vertices are spread out. Both give fewer than n - 3 diagonals when the
+// polygon is not simple
+template<typename T>
+std::vector<std::pair<int, int>> triangulate(std::vector<point<T>> &polygon, diagonal_graph &graph, bool ears) {
+    return ears ? triangulate_by_ears(polygon) : triangulate(polygon, graph);
+}
+
+// triangles[3 * t..3 * t + 2] are the counter-clockwise vertices of triangle t, neighbours[3 * t + k]
+// is the triangle across its edge from corner k to corner k + 1, or -1 on the polygon border
+class triangle_mesh {
+public:
+    int *triangles;
+    int *neighbours;
+    int size;
+};
+
+// fills caller buffers of 3 * (n - 2) ints each from the diagonals of a counter-clockwise polygon. The mesh is
+// empty when the faces are not n - 2 triangles, as for the diagonals of a polygon that is not simple
+template<typename T>
+triangle_mesh build_mesh(std::vector<point<T>> &polygon, std::vector<std::pair<int, int>> &diagonals,
+                         int *triangles, int *neighbours, diagonal_graph &graph) {
+    int n = polygon.size();
+    graph.build(polygon, diagonals);
+    bool triangles_only = true;
+    int corners = 0;
+    // keep the edge of every corner until all faces are numbered
+    int size = graph.walk_faces([&](int face, int corner, int e) {
+        if (face >= n - 2 || corner >= 3) {
+            triangles_only = false;
+            return;
+        }
+        triangles[3 * face + corner] = graph.origin(e);
+        neighbours[3 * face + corner] = e;
+        corners++;
+    });
+    if (!triangles_only || size != n - 2 || corners != 3 * size) {
+        return {triangles, neighbours, 0};
+    }
+    for (int i = 0; i < 3 * size; i++) {
+        neighbours[i] = graph.faces[graph.twins[neighbours[i]]];
+    }
+    return {triangles, neighbours, size};
+}
+
+template<typename T>
+triangle_mesh triangulate(std::vector<point<T>> &polygon, int *triangles, int *neighbours, diagonal_graph &graph) {
+    std::vector<std::pair<int, int>> diagonals = triangulate(polygon, graph);
+    return build_mesh(polygon, diagonals, triangles, neighbours, graph);
+}
+
+template<typename T>
+triangle_mesh triangulate(std::vector<point<T>> &polygon, int *triangles, int *neighbours) {
+    diagonal_graph graph;
+    return triangulate(polygon, triangles, neighbours, graph);
+}
+
+// vertex and triangle counts as uint32, the vertices as int64 pairs, then the triangles and their neighbours
+template<typename T>
+void write_mesh(std::ostream &out, std::vector<point<T>> &polygon, triangle_mesh &mesh) {
+    uint32_t header[2] = {(uint32_t) polygon.size(), (uint32_t) mesh.size};
+    out.write(reinterpret_cast<const char *>(header), sizeof(header));
+    for (point<T> &p : polygon) {
+        int64_t coordinates[2] = {(int64_t) p.x, (int64_t) p.y};
+        out.write(reinterpret_cast<const char *>(coordinates), sizeof(coordinates));
+    }
+    out.write(reinterpret_cast<const char *>(mesh.triangles), 3 * sizeof(int32_t) * mesh.size);
+    out.write(reinterpret_cast<const char *>(mesh.neighbours), 3 * sizeof(int32_t) * mesh.size);
+}
+
 template<typename T>
 bool is_clock_wise_orientation(std::vector<point<T>> &polygon) {
-    long long square = 0;
+    typename wider<T>::type square = 0;
     for (int i = 0; i < polygon.size(); i++) {
         int j = (i + 1) % polygon.size();
-        square += (polygon[i].x * polygon[j].y - polygon[i].y * polygon[j].x);
+        square += cross(polygon[i].x, polygon[i].y, polygon[j].x, polygon[j].y);
     }
     return square < 0;
 
 }
 
-void solveI() {
-    int n;
-    std::cin >> n;
-    std::vector<point<long long>> polygon;
-    for (int i = 0; i < n; i++) {
-        int x, y;
-        std::cin >> x >> y;
-        polygon.emplace_back(x, y);
+// false when the polygon is not simple, nothing is written then
+bool solveI(const char *mesh_path, bool binary, bool ears) {
+    std::vector<point<long long>> input_polygon;
+    {
+        INSTRUMENT_PHASE("read");
+        input_reader input;
+        int n = input.read<int>();
+        input_polygon = input.read_points<long long>(n);
     }
-    bool clock_wise = is_clock_wise_orientation(polygon);
-    if (clock_wise) {
+    std::vector<point<long long>> polygon = input_polygon;
+    // the answer is given in input indices, original follows the polygon through the reversal
+    std::vector<int> original = remove_repeated_vertices(polygon);
+    int n = polygon.size();
+    if (is_clock_wise_orientation(polygon)) {
         std::reverse(polygon.begin(), polygon.end());
+        std::reverse(original.begin(), original.end());
+    }
+    diagonal_graph graph;
+    std::vector<std::pair<int, int>> diagonals;
+    if (n > 3) {
+        INSTRUMENT_PHASE("triangulate");
+        diagonals = triangulate(polygon, graph, ears);
+    }
+    int size = std::max(n - 2, 0);
+    std::vector<int> triangles(3 * size);
+    std::vector<int> neighbours(3 * size);
+    triangle_mesh mesh{triangles.data(), neighbours.data(), 0};
+    if (mesh_path != nullptr && n >= 3) {
+        mesh = build_mesh(polygon, diagonals, triangles.data(), neighbours.data(), graph);
+    }
+    if ((int) diagonals.size() != std::max(n - 3, 0) || mesh.size != (mesh_path != nullptr ? size : 0)) {
+        std::cerr << "the polygon is not simple\n";
+        return false;
     }
-    auto diagonals = triangulate(polygon);
+    INSTRUMENT_PHASE("output");
+    output_writer out(1, binary);
     for (auto diagonal : diagonals) {
-        if (clock_wise) {
-            std::cout << n - diagonal.first - 1 << ' ' << n - diagonal.second - 1 << '\n';
-        } else {
-            std::cout << diagonal.first << ' ' << diagonal.second << '\n';
+        out.write_integer(original[diagonal.first]);
+        out.write(' ');
+        out.write_integer(original[diagonal.second]);
+        out.write('\n');
+    }
+    if (mesh_path != nullptr) {
+        for (int &vertex : triangles) {
+            vertex = original[vertex];
+        }
+        std::ofstream mesh_file(mesh_path, std::ios::binary);
+        write_mesh(mesh_file, input_polygon, mesh);
+    }
+    return true;
+}
+
+// polygons as in solveI one after another until the end of input, each answer is followed by an empty line
+void solve_batch(int threads_count, bool binary, bool ears) {
+    std::vector<point<long long>> vertices;
+    std::vector<size_t> offsets = {0};
+    {
+        INSTRUMENT_PHASE("read");
+        input_reader input;
+        while (input.has_next()) {
+            int n = input.read<int>();
+            for (int i = 0; i < n && !input.fail(); i++) {
+                vertices.push_back(input.read_point<long long>());
+            }
+            if (input.fail()) {
+                // the polygon read last is incomplete, the ones before it are answered
+                vertices.resize(offsets.back());
+                std::cerr << "polygon " << offsets.size()
+                          << " is cut short or holds a token that is not a number, the input stops there\n";
+                break;
+            }
+            offsets.push_back(vertices.size());
+        }
+    }
+    size_t count = offsets.size() - 1;
+    std::vector<std::string> results(count);
+    // a polygon that is not simple gets an empty answer and is named on stderr, the others go on
+    std::vector<char> skipped(count, false);
+    const size_t CHUNK = 64;
+    std::atomic<size_t> next_chunk(0);
+    auto worker = [&]() {
+        diagonal_graph graph;
+        std::vector<point<long long>> polygon;
+        output_writer answer(-1, binary);
+        INSTRUMENT_PHASE("triangulate");
+        for (size_t begin = next_chunk.fetch_add(CHUNK); begin < count; begin = next_chunk.fetch_add(CHUNK)) {
+            for (size_t i = begin; i < std::min(begin + CHUNK, count); i++) {
+                polygon.assign(vertices.begin() + offsets[i], vertices.begin() + offsets[i + 1]);
+                std::vector<int> original = remove_repeated_vertices(polygon);
+                int size = polygon.size();
+                if (size > 3) {
+                    if (is_clock_wise_orientation(polygon)) {
+                        std::reverse(polygon.begin(), polygon.end());
+                        std::reverse(original.begin(), original.end());
+                    }
+                    std::vector<std::pair<int, int>> diagonals = triangulate(polygon, graph, ears);
+                    skipped[i] = (int) diagonals.size() != size - 3;
+                    for (size_t d = 0; !skipped[i] && d < diagonals.size(); d++) {
+                        answer.write_integer(original[diagonals[d].first]);
+                        answer.write(' ');
+                        answer.write_integer(original[diagonals[d].second]);
+                        answer.write('\n');
+                    }
+                }
+                answer.write('\n');
+                results[i].assign(answer.data(), answer.size());
+                answer.clear();
+            }
         }
+    };
+    std::vector<std::thread> threads;
+    for (int t = 1; t < threads_count; t++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (skipped[i]) {
+            std::cerr << "polygon " << i + 1 << " is not simple, skipped\n";
+        }
+    }
+    INSTRUMENT_PHASE("output");
+    output_writer out(1, binary);
+    for (std::string &result : results) {
+        out.write_bytes(result.data(), result.size());
     }
 }
 
-int main() {
-    solveI();
-}
\ No newline at end of file
+// i [--mesh <file>] [--binary] [--ears] | i --batch [--binary] [--ears]
+int main(int argc, char **argv) {
+    const char *mesh_path = nullptr;
+    bool batch = false;
+    bool binary = false;
+    bool ears = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::string(argv[i]) == "--batch") {
+            batch = true;
+        }
+        if (std::string(argv[i]) == "--binary") {
+            binary = true;
+        }
+        if (std::string(argv[i]) == "--ears") {
+            ears = true;
+        }
+        if (std::string(argv[i]) == "--mesh" && i + 1 < argc) {
+            mesh_path = argv[i + 1];
+        }
+    }
+    if (batch) {
+        solve_batch(std::max(1u, std::thread::hardware_concurrency()), binary, ears);
+        return 0;
+    }
+    return solveI(mesh_path, binary, ears) ? 0 : 1;
+}
@@ -0,0 +1,258 @@
+#ifndef GEOMETRY_INPUT_H
+#define GEOMETRY_INPUT_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "geometry.h"
+
+// input starting with these 8 bytes is binary: a sequence of native 8-byte values, int64 for every integer
+// read and double for every decimal one, so a solver takes both formats without changes
+const char BINARY_INPUT_MAGIC[8] = {'G', 'E', 'O', 'B', 'I', 'N', '\n', '\0'};
+
+// the whole input in memory at once: mapped when it is a regular file, read in large blocks otherwise,
+// then scanned in place without iostreams
+class input_reader {
+private:
+    const char *current;
+    const char *end;
+    void *mapped;
+    size_t mapped_size;
+    std::vector<char> buffer;
+    bool binary;
+    bool failed;
+
+    // exact powers of ten, 10^27 still fits the 64-bit long double mantissa
+    static long double power_of_ten(int exponent) {
+        static const long double POWERS[] = {
+                1e0L, 1e1L, 1e2L, 1e3L, 1e4L, 1e5L, 1e6L, 1e7L, 1e8L, 1e9L, 1e10L, 1e11L, 1e12L, 1e13L,
+                1e14L, 1e15L, 1e16L, 1e17L, 1e18L, 1e19L, 1e20L, 1e21L, 1e22L, 1e23L, 1e24L, 1e25L, 1e26L, 1e27L};
+        return POWERS[exponent];
+    }
+
+    static bool is_digit(char c) {
+        return (unsigned char) (c - '0') < 10;
+    }
+
+    // eight ASCII digits in one little-endian word, checked and converted without a loop
+    static bool is_eight_digits(uint64_t chunk) {
+        return ((chunk & 0xF0F0F0F0F0F0F0F0ULL) | (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4))
+               == 0x3333333333333333ULL;
+    }
+
+    static uint32_t parse_eight_digits(uint64_t chunk) {
+        chunk = (chunk & 0x0F0F0F0F0F0F0F0FULL) * 2561 >> 8;
+        chunk = (chunk & 0x00FF00FF00FF00FFULL) * 6553601 >> 16;
+        return (uint32_t) ((chunk & 0x0000FFFF0000FFFFULL) * 42949672960001ULL >> 32);
+    }
+
+    void skip_whitespace() {
+        while (current < end && (unsigned char) *current <= ' ') {
+            current++;
+        }
+    }
+
+    template<typename V>
+    V read_raw() {
+        V value = 0;
+        if (end - current >= (std::ptrdiff_t) sizeof(V)) {
+            std::memcpy(&value, current, sizeof(V));
+            current += sizeof(V);
+        } else {
+            current = end;
+            failed = true;
+        }
+        return value;
+    }
+
+    // digits of the unsigned part, eight at a time while they last
+    uint64_t read_digits(uint64_t value, int &count) {
+        uint64_t chunk;
+        while (end - current >= 8 && (std::memcpy(&chunk, current, 8), is_eight_digits(chunk))) {
+            value = value * 100000000 + parse_eight_digits(chunk);
+            current += 8;
+            count += 8;
+        }
+        while (current < end && is_digit(*current)) {
+            value = value * 10 + (*current - '0');
+            current++;
+            count++;
+        }
+        return value;
+    }
+
+    // the rest of a token that is not a number, so the next read starts after it
+    void skip_token() {
+        while (current < end && (unsigned char) *current > ' ') {
+            current++;
+        }
+        failed = true;
+    }
+
+    // exponents, infinities, more digits than the fast path keeps exactly, and tokens that are not numbers
+    long double read_decimal_slowly(const char *start) {
+        current = start;
+        while (current < end && (unsigned char) *current > ' ') {
+            current++;
+        }
+        std::string token(start, current);
+        char *parsed;
+        long double value = std::strtold(token.c_str(), &parsed);
+        failed |= token.empty() || *parsed != '\0';
+        return value;
+    }
+
+public:
+    explicit input_reader(int fd = 0)
+            : current(nullptr), end(nullptr), mapped(nullptr), mapped_size(0), failed(false) {
+        struct stat info{};
+        if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+            void *data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED) {
+                mapped = data;
+                mapped_size = info.st_size;
+                madvise(mapped, mapped_size, MADV_SEQUENTIAL);
+                current = static_cast<const char *>(mapped);
+                end = current + mapped_size;
+            }
+        }
+        if (mapped == nullptr) {
+            const size_t BLOCK = 1 << 20;
+            size_t size = 0;
+            while (true) {
+                buffer.resize(size + BLOCK);
+                ssize_t count = ::read(fd, buffer.data() + size, BLOCK);
+                if (count <= 0) {
+                    break;
+                }
+                size += count;
+            }
+            buffer.resize(size);
+            current = buffer.data();
+            end = current + size;
+        }
+        binary = end - current >= 8 && std::memcmp(current, BINARY_INPUT_MAGIC, 8) == 0;
+        if (binary) {
+            current += 8;
+        } else if (end - current >= 3 && std::memcmp(current, "\xEF\xBB\xBF", 3) == 0) {
+            // UTF-8 byte order mark
+            current += 3;
+        }
+    }
+
+    input_reader(const input_reader &) = delete;
+
+    input_reader &operator=(const input_reader &) = delete;
+
+    ~input_reader() {
+        if (mapped != nullptr) {
+            munmap(mapped, mapped_size);
+        }
+    }
+
+    bool is_binary() const {
+        return binary;
+    }
+
+    // set by a token that is not a number; it is skipped and read as 0
+    bool fail() const {
+        return failed;
+    }
+
+    // false once only whitespace is left or a read has failed, the counterpart of `while (std::cin >> n)`
+    bool has_next() {
+        if (!binary) {
+            skip_whitespace();
+        }
+        return !failed && current < end;
+    }
+
+    template<typename T>
+    T read_integer() {
+        if (binary) {
+            return (T) read_raw<int64_t>();
+        }
+        skip_whitespace();
+        bool negative = false;
+        if (current < end && (*current == '-' || *current == '+')) {
+            negative = *current == '-';
+            current++;
+        }
+        int count = 0;
+        uint64_t value = read_digits(0, count);
+        if (count == 0 || (current < end && (unsigned char) *current > ' ')) {
+            skip_token();
+            return 0;
+        }
+        return negative ? (T) -(int64_t) value : (T) value;
+    }
+
+    template<typename T>
+    T read_decimal() {
+        if (binary) {
+            return (T) read_raw<double>();
+        }
+        skip_whitespace();
+        const char *start = current;
+        bool negative = false;
+        if (current < end && (*current == '-' || *current == '+')) {
+            negative = *current == '-';
+            current++;
+        }
+        int digits = 0;
+        uint64_t mantissa = read_digits(0, digits);
+        int fraction = 0;
+        if (current < end && *current == '.') {
+            current++;
+            mantissa = read_digits(mantissa, fraction);
+            digits += fraction;
+        }
+        // up to 19 digits fit the mantissa, and the quotient of two exact long doubles is correctly rounded
+        if (digits == 0 || digits > 19 || fraction > 27 || (current < end && (unsigned char) *current > ' ')) {
+            return (T) read_decimal_slowly(start);
+        }
+        long double value = (long double) mantissa / power_of_ten(fraction);
+        return (T) (negative ? -value : value);
+    }
+
+    template<typename T>
+    T read() {
+        return std::is_integral<T>::value ? read_integer<T>() : read_decimal<T>();
+    }
+
+    template<typename T>
+    point<T> read_point() {
+        T x = read<T>();
+        T y = read<T>();
+        return point<T>(x, y);
+    }
+
+    template<typename T>
+    std::vector<point<T>> read_points(size_t n) {
+        std::vector<point<T>> points(n);
+        for (point<T> &p : points) {
+            p.x = read<T>();
+            p.y = read<T>();
+        }
+        return points;
+    }
+
+    // coordinates straight into separate x and y arrays
+    template<typename T>
+    void read_coordinates(size_t n, T *xs, T *ys) {
+        for (size_t i = 0; i < n; i++) {
+            xs[i] = read<T>();
+            ys[i] = read<T>();
+        }
+    }
+};
+
+#endif //GEOMETRY_INPUT_H
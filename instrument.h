@@ -0,0 +1,298 @@
+#ifndef GEOMETRY_INSTRUMENT_H
+#define GEOMETRY_INSTRUMENT_H
+
+// counters, maxima and phase timers for the hot paths. They are compiled in only with -DGEOMETRY_INSTRUMENT
+// (the CMake option of the same name), otherwise every macro below is empty.
+//
+//   INSTRUMENT_COUNT("name")          one more event
+//   INSTRUMENT_ADD("name", amount)    several events
+//   INSTRUMENT_MAX("name", value)     the largest value seen
+//   INSTRUMENT_PHASE("name")          wall time of the enclosing scope, plus hardware counters when enabled
+//
+// Names must be string literals. Every thread counts into its own table, tables are merged by name when their
+// thread ends, and the totals are written as JSON at exit to $GEOMETRY_INSTRUMENT_OUTPUT or to stderr.
+// GEOMETRY_PERF=1 adds cycles, instructions, cache misses and branch misses to the phases via perf_event_open
+#ifdef GEOMETRY_INSTRUMENT
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+enum instrument_kind {
+    INSTRUMENT_COUNTER,
+    INSTRUMENT_MAXIMUM,
+    INSTRUMENT_PHASE_TIME
+};
+
+const int HARDWARE_EVENTS = 4;
+
+class instrument_entry {
+public:
+    const char *name;
+    instrument_kind kind;
+    // the count, the maximum or the nanoseconds of a phase
+    long long value;
+    long long calls;
+    long long hardware[HARDWARE_EVENTS];
+};
+
+class instrument_registry;
+
+inline instrument_registry &instrument_totals();
+
+// the table of one thread, open addressing on the address of the name literal
+class instrument_table {
+public:
+    // distinct names per thread, far more than the solutions use
+    static const int SLOTS = 1024;
+
+    instrument_entry entries[SLOTS];
+    int hardware_fds[HARDWARE_EVENTS];
+    bool hardware_opened;
+
+    instrument_table();
+
+    ~instrument_table();
+
+    instrument_entry &find(const char *name, instrument_kind kind) {
+        size_t slot = (size_t) ((uintptr_t) name * 0x9e3779b97f4a7c15ULL >> 54);
+        while (entries[slot].name != nullptr && entries[slot].name != name) {
+            slot = (slot + 1) & (SLOTS - 1);
+        }
+        instrument_entry &entry = entries[slot];
+        if (entry.name == nullptr) {
+            entry.name = name;
+            entry.kind = kind;
+        }
+        return entry;
+    }
+
+    // counters of this thread only, opened on the first phase when GEOMETRY_PERF is set
+    void read_hardware(long long *values) {
+        if (!hardware_opened) {
+            open_hardware();
+        }
+        for (int i = 0; i < HARDWARE_EVENTS; i++) {
+            values[i] = 0;
+            if (hardware_fds[i] >= 0 && ::read(hardware_fds[i], &values[i], sizeof(long long)) != sizeof(long long)) {
+                values[i] = 0;
+            }
+        }
+    }
+
+private:
+    void open_hardware() {
+        hardware_opened = true;
+        const char *enabled = std::getenv("GEOMETRY_PERF");
+        if (enabled == nullptr || std::strcmp(enabled, "1") != 0) {
+            return;
+        }
+        const uint64_t EVENTS[HARDWARE_EVENTS] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                                  PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+        for (int i = 0; i < HARDWARE_EVENTS; i++) {
+            perf_event_attr attributes{};
+            attributes.type = PERF_TYPE_HARDWARE;
+            attributes.size = sizeof(attributes);
+            attributes.config = EVENTS[i];
+            attributes.exclude_kernel = 1;
+            attributes.exclude_hv = 1;
+            hardware_fds[i] = (int) syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+        }
+    }
+};
+
+class instrument_total {
+public:
+    instrument_kind kind;
+    long long value;
+    long long calls;
+    long long hardware[HARDWARE_EVENTS];
+};
+
+// live tables and the totals of finished threads; never destroyed, so it outlives every thread_local
+class instrument_registry {
+public:
+    std::mutex mutex;
+    std::vector<instrument_table *> live;
+    std::map<std::string, instrument_total> totals;
+    int threads;
+    bool hardware;
+
+    instrument_registry() : threads(0), hardware(false) {
+        std::atexit([]() {
+            instrument_totals().dump();
+        });
+    }
+
+    // under the mutex
+    void merge(const instrument_table &table) {
+        for (const instrument_entry &entry : table.entries) {
+            if (entry.name == nullptr) {
+                continue;
+            }
+            auto inserted = totals.insert({entry.name, instrument_total{entry.kind, 0, 0, {}}});
+            instrument_total &total = inserted.first->second;
+            if (entry.kind == INSTRUMENT_MAXIMUM) {
+                total.value = inserted.second ? entry.value : std::max(total.value, entry.value);
+            } else {
+                total.value += entry.value;
+            }
+            total.calls += entry.calls;
+            for (int i = 0; i < HARDWARE_EVENTS; i++) {
+                total.hardware[i] += entry.hardware[i];
+            }
+        }
+        for (int fd : table.hardware_fds) {
+            hardware |= fd >= 0;
+        }
+    }
+
+    void dump() {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (instrument_table *table : live) {
+            merge(*table);
+        }
+        live.clear();
+        const char *path = std::getenv("GEOMETRY_INSTRUMENT_OUTPUT");
+        FILE *out = path != nullptr ? std::fopen(path, "w") : nullptr;
+        if (out == nullptr) {
+            out = stderr;
+        }
+        const char *HARDWARE_NAMES[HARDWARE_EVENTS] = {"cycles", "instructions", "cache_misses", "branch_misses"};
+        const char *SECTIONS[] = {"counters", "maxima", "phases"};
+        std::fprintf(out, "{\"threads\": %d, \"hardware_counters\": %s", threads, hardware ? "true" : "false");
+        for (int kind = INSTRUMENT_COUNTER; kind <= INSTRUMENT_PHASE_TIME; kind++) {
+            std::fprintf(out, ",\n \"%s\": {", SECTIONS[kind]);
+            const char *separator = "";
+            for (auto &named : totals) {
+                const instrument_total &total = named.second;
+                if (total.kind != kind) {
+                    continue;
+                }
+                std::fprintf(out, "%s\n  \"%s\": ", separator, named.first.c_str());
+                separator = ",";
+                if (kind != INSTRUMENT_PHASE_TIME) {
+                    std::fprintf(out, "%lld", total.value);
+                    continue;
+                }
+                std::fprintf(out, "{\"calls\": %lld, \"seconds\": %.9f", total.calls, total.value * 1e-9);
+                for (int i = 0; hardware && i < HARDWARE_EVENTS; i++) {
+                    std::fprintf(out, ", \"%s\": %lld", HARDWARE_NAMES[i], total.hardware[i]);
+                }
+                std::fprintf(out, "}");
+            }
+            std::fprintf(out, "%s}", *separator != '\0' ? "\n " : "");
+        }
+        std::fprintf(out, "\n}\n");
+        if (out != stderr) {
+            std::fclose(out);
+        }
+    }
+};
+
+inline instrument_registry &instrument_totals() {
+    static instrument_registry *registry = new instrument_registry();
+    return *registry;
+}
+
+inline instrument_table::instrument_table() : entries(), hardware_opened(false) {
+    for (int &fd : hardware_fds) {
+        fd = -1;
+    }
+    instrument_registry &registry = instrument_totals();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.live.push_back(this);
+    registry.threads++;
+}
+
+inline instrument_table::~instrument_table() {
+    instrument_registry &registry = instrument_totals();
+    {
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto it = std::find(registry.live.begin(), registry.live.end(), this);
+        if (it != registry.live.end()) {
+            registry.live.erase(it);
+            registry.merge(*this);
+        }
+    }
+    for (int fd : hardware_fds) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+}
+
+inline instrument_table &instrument_local() {
+    static thread_local instrument_table table;
+    return table;
+}
+
+inline void instrument_add(const char *name, long long amount) {
+    instrument_entry &entry = instrument_local().find(name, INSTRUMENT_COUNTER);
+    entry.value += amount;
+    entry.calls++;
+}
+
+inline void instrument_maximum(const char *name, long long value) {
+    instrument_entry &entry = instrument_local().find(name, INSTRUMENT_MAXIMUM);
+    entry.value = entry.calls == 0 ? value : std::max(entry.value, value);
+    entry.calls++;
+}
+
+// inclusive: a nested phase is also counted in the one around it
+class phase_timer {
+private:
+    instrument_table &table;
+    instrument_entry &entry;
+    std::chrono::steady_clock::time_point start;
+    long long hardware[HARDWARE_EVENTS];
+
+public:
+    explicit phase_timer(const char *name) : table(instrument_local()), entry(table.find(name, INSTRUMENT_PHASE_TIME)) {
+        table.read_hardware(hardware);
+        start = std::chrono::steady_clock::now();
+    }
+
+    phase_timer(const phase_timer &) = delete;
+
+    phase_timer &operator=(const phase_timer &) = delete;
+
+    ~phase_timer() {
+        entry.value += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count();
+        entry.calls++;
+        long long now[HARDWARE_EVENTS];
+        table.read_hardware(now);
+        for (int i = 0; i < HARDWARE_EVENTS; i++) {
+            entry.hardware[i] += now[i] - hardware[i];
+        }
+    }
+};
+
+#define INSTRUMENT_CONCAT_(a, b) a##b
+#define INSTRUMENT_CONCAT(a, b) INSTRUMENT_CONCAT_(a, b)
+#define INSTRUMENT_COUNT(name) instrument_add(name, 1)
+#define INSTRUMENT_ADD(name, amount) instrument_add(name, (long long) (amount))
+#define INSTRUMENT_MAX(name, value) instrument_maximum(name, (long long) (value))
+#define INSTRUMENT_PHASE(name) phase_timer INSTRUMENT_CONCAT(instrument_phase_, __LINE__)(name)
+
+#else
+
+#define INSTRUMENT_COUNT(name) ((void) 0)
+#define INSTRUMENT_ADD(name, amount) ((void) 0)
+#define INSTRUMENT_MAX(name, value) ((void) 0)
+#define INSTRUMENT_PHASE(name) ((void) 0)
+
+#endif //GEOMETRY_INSTRUMENT
+
+#endif //GEOMETRY_INSTRUMENT_H
@@ -3,44 +3,67 @@
 #include <vector>
 #include <map>
 #include <set>
-#include <iomanip>
 #include <algorithm>
+#include <tuple>
+#include <cstdint>
+#include <thread>
+#include <string>
 
-template<typename T>
-class point {
+#include "geometry.h"
+#include "input.h"
+#include "output.h"
+
+
+// x / w, y / w with w > 0. For lines through int points the numerators stay below 2^97 and w below 2^65,
+// and the comparisons take their cross products in 256 bits, so they are exact for every input
+class homogeneous_point {
 public:
-    T x;
-    T y;
+    __int128 x;
+    __int128 y;
+    __int128 w;
 
-    point() = default;
+    homogeneous_point() = default;
+
+    homogeneous_point(__int128 x, __int128 y, __int128 w) : x(x), y(y), w(w) {
+        if (w < 0) {
+            this->x = -x;
+            this->y = -y;
+            this->w = -w;
+        }
+    }
 
-    point(T x, T y) : x(x), y(y) {}
+    bool operator<(const homogeneous_point &other) const {
+        int by_x = compare_products(x, other.w, other.x, w);
+        return by_x < 0 || (by_x == 0 && compare_products(y, other.w, other.y, w) < 0);
+    }
 
-    bool operator==(const point<T> &other) const {
-        return x == other.x && y == other.y;
+    bool operator==(const homogeneous_point &other) const {
+        return compare_products(x, other.w, other.x, w) == 0 && compare_products(y, other.w, other.y, w) == 0;
     }
 
-    bool operator<(const point<T> &other) const {
-        return x < other.x || (x == other.x && y < other.y);
+    point<long double> to_point() const {
+        return {(long double) x / (long double) w, (long double) y / (long double) w};
     }
 };
 
-
+// a x + b y + c = 0
 template<typename T>
 class line {
 
 public:
+    typedef typename wider<T>::type W;
+
     point<T> s;
     point<T> e;
-    T a;
-    T b;
-    T c;
+    W a;
+    W b;
+    W c;
 
     line() = default;
 
     line(point<T> s, point<T> e) : s(s), e(e) {
-        a = s.y - e.y;
-        b = e.x - s.x;
+        a = (W) s.y - e.y;
+        b = (W) e.x - s.x;
         c = -a * s.x - b * s.y;
     }
 
@@ -52,171 +75,651 @@ public:
         return is_parallel(other) && (c * other.a == other.c * a) && (c * other.b == other.c * b);
     }
 
-    point<long double> intersection(line &l) {
-        return {(long double)(l.c * b - c * l.b) / (long double) (a * l.b - l.a * b), (long double) (c * l.a - l.c * a) / (long double)(l.b * a - b * l.a)};
+    homogeneous_point intersection(line &l) {
+        return {(__int128) l.c * b - (__int128) c * l.b, (__int128) c * l.a - (__int128) l.c * a,
+                (__int128) a * l.b - (__int128) l.a * b};
     }
 
-    bool contains(point<long double> p) {
-        return (std::abs(a * p.x + b * p.y + c) < 1e-10);
+    // the same line always gets the same coefficients
+    line<T> normalized() const {
+        line<T> result = *this;
+        W g = std::__gcd(std::__gcd(std::abs(a), std::abs(b)), std::abs(c));
+        int sign = (a < 0 || (a == 0 && b < 0)) ? -1 : 1;
+        result.a = sign * a / g;
+        result.b = sign * b / g;
+        result.c = sign * c / g;
+        return result;
     }
-};
 
-class edge {
-public:
-    edge *twin;
-    edge *next;
-    edge *prev;
-    int s_index;
-    int e_index;
-    bool has_face;
-    int index;
+    bool operator<(const line<T> &other) const {
+        return std::tie(a, b, c) < std::tie(other.a, other.b, other.c);
+    }
 
-    edge(int s_index, int e_index, int index) : s_index(s_index), e_index(e_index), index(index) {
-        twin = nullptr;
-        next = nullptr;
-        prev = nullptr;
-        has_face = false;
+    // whichever of b, -a and -b, a is lexicographically positive
+    void direction(W &x, W &y) const {
+        bool flip = b < 0 || (b == 0 && a > 0);
+        x = flip ? -b : b;
+        y = flip ? a : -a;
     }
+};
 
+// half-edges 2k and 2k + 1 are twins, 2k goes from the lexicographically smaller vertex to the larger one
+class half_edge {
+public:
+    uint32_t origin;
+    uint32_t next;
+    uint32_t face;
+    uint32_t line;
 };
 
-class vertex {
+// flat arrays with 32-bit indices; the half-edges leaving vertex v are
+// vertex_edges[offsets[v]..offsets[v + 1]) in counter-clockwise order and every face lies to the left of its edges
+class DCEL {
 public:
-    point<long double> p;
-    std::vector<edge *> edges;
+    std::vector<point<long double>> vertices;
+    std::vector<half_edge> edges;
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> vertex_edges;
+    std::vector<uint32_t> faces;
+
+    uint32_t target(uint32_t e) const {
+        return edges[e ^ 1].origin;
+    }
 };
 
-struct DCEL {
-    std::vector<vertex> vertices;
-    std::vector<edge *> edges;
+// the intersection produced by a pair of lines
+class pair_intersection {
+public:
+    homogeneous_point p;
+    int first;
+    int second;
+
+    bool operator<(const pair_intersection &other) const {
+        return p < other.p;
+    }
 };
 
-DCEL lines_to_DCEL(std::vector<line<int>> &lines) {
-    std::set<point<long double>> intersections;
-    for (int i = 0; i < lines.size(); i++) {
-        for (int j = i + 1; j < lines.size(); j++) {
-            if (lines[i] == lines[j] || lines[i].is_parallel(lines[j])) {
-                continue;
+template<typename F>
+void parallel_for(int threads_count, F f) {
+    std::vector<std::thread> threads;
+    for (int t = 1; t < threads_count; t++) {
+        threads.emplace_back(f, t);
+    }
+    f(0);
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+// sorts every buffer on its own thread, then merges them pairwise in rounds
+template<typename T>
+std::vector<T> parallel_sort(std::vector<std::vector<T>> &buffers) {
+    parallel_for(buffers.size(), [&](int t) {
+        std::sort(buffers[t].begin(), buffers[t].end());
+    });
+    while (buffers.size() > 1) {
+        std::vector<std::vector<T>> merged((buffers.size() + 1) / 2);
+        parallel_for(merged.size(), [&](int t) {
+            if (2 * t + 1 == buffers.size()) {
+                merged[t].swap(buffers[2 * t]);
+                return;
+            }
+            merged[t].resize(buffers[2 * t].size() + buffers[2 * t + 1].size());
+            std::merge(buffers[2 * t].begin(), buffers[2 * t].end(), buffers[2 * t + 1].begin(),
+                       buffers[2 * t + 1].end(), merged[t].begin());
+            std::vector<T>().swap(buffers[2 * t]);
+            std::vector<T>().swap(buffers[2 * t + 1]);
+        });
+        buffers.swap(merged);
+    }
+    return std::move(buffers[0]);
+}
+
+// counter-clockwise angular order of directions starting from the positive x axis
+template<typename T>
+bool is_before_by_angle(T ax, T ay, T bx, T by) {
+    bool a_lower = ay < 0 || (ay == 0 && ax < 0);
+    bool b_lower = by < 0 || (by == 0 && bx < 0);
+    if (a_lower != b_lower) {
+        return b_lower;
+    }
+    return cross(ax, ay, bx, by) > 0;
+}
+
+// orders the half-edges around every vertex by the exact directions of their lines, links them into faces
+template<typename T>
+void link_faces(DCEL &dcel, std::vector<line<T>> &lines, int threads_count) {
+    uint32_t n = dcel.vertices.size();
+    dcel.offsets.assign(n + 1, 0);
+    for (half_edge &e : dcel.edges) {
+        dcel.offsets[e.origin + 1]++;
+    }
+    for (uint32_t v = 0; v < n; v++) {
+        dcel.offsets[v + 1] += dcel.offsets[v];
+    }
+    dcel.vertex_edges.resize(dcel.edges.size());
+    std::vector<uint32_t> filled(dcel.offsets.begin(), dcel.offsets.end() - 1);
+    for (uint32_t e = 0; e < dcel.edges.size(); e++) {
+        dcel.vertex_edges[filled[dcel.edges[e].origin]++] = e;
+    }
+    auto direction = [&](uint32_t e, typename line<T>::W &x, typename line<T>::W &y) {
+        lines[dcel.edges[e].line].direction(x, y);
+        if (e & 1) {
+            x = -x;
+            y = -y;
+        }
+    };
+    // every vertex only writes the edges coming into it
+    parallel_for(threads_count, [&](int t) {
+        for (uint32_t v = (uint64_t) n * t / threads_count; v < (uint64_t) n * (t + 1) / threads_count; v++) {
+            auto begin = dcel.vertex_edges.begin() + dcel.offsets[v];
+            auto end = dcel.vertex_edges.begin() + dcel.offsets[v + 1];
+            std::sort(begin, end, [&](uint32_t a, uint32_t b) {
+                typename line<T>::W ax, ay, bx, by;
+                direction(a, ax, ay);
+                direction(b, bx, by);
+                return is_before_by_angle(ax, ay, bx, by);
+            });
+            // the face left of an edge coming into v continues along the next edge clockwise from its twin
+            for (auto it = begin; it != end; it++) {
+                dcel.edges[*it ^ 1].next = it == begin ? *(end - 1) : *(it - 1);
             }
-            intersections.insert(lines[i].intersection(lines[j]));
         }
+    });
+    const uint32_t NO_FACE = UINT32_MAX;
+    for (half_edge &e : dcel.edges) {
+        e.face = NO_FACE;
+    }
+    dcel.faces.clear();
+    for (uint32_t start = 0; start < dcel.edges.size(); start++) {
+        if (dcel.edges[start].face != NO_FACE) {
+            continue;
+        }
+        for (uint32_t e = start; dcel.edges[e].face == NO_FACE; e = dcel.edges[e].next) {
+            dcel.edges[e].face = dcel.faces.size();
+        }
+        dcel.faces.push_back(start);
     }
-    std::vector<vertex> vertices;
-    vertices.reserve(intersections.size());
-    for (auto p : intersections) {
-        vertices.push_back({p, {}});
+}
+
+// distinct lines with normalized coefficients
+std::vector<line<int>> normalize_lines(std::vector<line<int>> &input_lines) {
+    std::vector<line<int>> lines;
+    lines.reserve(input_lines.size());
+    for (auto &l : input_lines) {
+        lines.push_back(l.normalized());
     }
-    std::vector<edge *> edges;
-    for (auto l : lines) {
-        std::vector<std::pair<point<long double>, int>> points_on_line;
-        for (int i = 0; i < vertices.size(); i++) {
-            if (l.contains(vertices[i].p)) {
-                points_on_line.emplace_back(vertices[i].p, i);
+    std::sort(lines.begin(), lines.end());
+    lines.erase(std::unique(lines.begin(), lines.end()), lines.end());
+    return lines;
+}
+
+// the arrangement of distinct normalized lines cut down to the intersections accepted by keep
+template<typename F>
+void build_DCEL(std::vector<line<int>> &lines, DCEL &dcel, int threads_count, F keep) {
+    // rows are dealt out round-robin so every thread gets about the same number of pairs
+    std::vector<std::vector<pair_intersection>> buffers(threads_count);
+    parallel_for(threads_count, [&](int t) {
+        for (int i = t; i < lines.size(); i += threads_count) {
+            for (int j = i + 1; j < lines.size(); j++) {
+                if (lines[i].is_parallel(lines[j])) {
+                    continue;
+                }
+                homogeneous_point p = lines[i].intersection(lines[j]);
+                if (keep(p)) {
+                    buffers[t].push_back({p, i, j});
+                }
             }
         }
-        std::sort(points_on_line.begin(), points_on_line.end());
-        for (int i = 0; i + 1 < points_on_line.size(); i++) {
-            edge *e1 = new edge(points_on_line[i].second,
-                                points_on_line[i + 1].second, (int) edges.size());
-            edge *e2 = new edge(points_on_line[i + 1].second,
-                                points_on_line[i].second, (int) edges.size() + 1);
-            e1->twin = e2;
-            e2->twin = e1;
-            edges.push_back(e1);
-            edges.push_back(e2);
+    });
+    std::vector<pair_intersection> intersections = parallel_sort(buffers);
+    // vertices are numbered in lexicographic order, which is also their order along every line
+    size_t size = intersections.size();
+    auto is_new_vertex = [&](size_t i) {
+        return i == 0 || !(intersections[i].p == intersections[i - 1].p);
+    };
+    std::vector<int> first_vertex(threads_count + 1, 0);
+    parallel_for(threads_count, [&](int t) {
+        for (size_t i = size * t / threads_count; i < size * (t + 1) / threads_count; i++) {
+            first_vertex[t + 1] += is_new_vertex(i);
+        }
+    });
+    for (int t = 0; t < threads_count; t++) {
+        first_vertex[t + 1] += first_vertex[t];
+    }
+    dcel.vertices.resize(first_vertex[threads_count]);
+    std::vector<int> vertex_of(size);
+    parallel_for(threads_count, [&](int t) {
+        int vertex = first_vertex[t] - 1;
+        for (size_t i = size * t / threads_count; i < size * (t + 1) / threads_count; i++) {
+            if (is_new_vertex(i)) {
+                dcel.vertices[++vertex] = intersections[i].p.to_point();
+            }
+            vertex_of[i] = vertex;
+        }
+    });
+    std::vector<int> offsets(lines.size() + 1, 0);
+    for (pair_intersection &intersection : intersections) {
+        offsets[intersection.first + 1]++;
+        offsets[intersection.second + 1]++;
+    }
+    for (int i = 0; i < lines.size(); i++) {
+        offsets[i + 1] += offsets[i];
+    }
+    std::vector<int> points_on_lines(offsets.back());
+    std::vector<int> filled(offsets.begin(), offsets.end() - 1);
+    for (int i = 0; i < intersections.size(); i++) {
+        points_on_lines[filled[intersections[i].first]++] = vertex_of[i];
+        points_on_lines[filled[intersections[i].second]++] = vertex_of[i];
+    }
+    dcel.edges.clear();
+    dcel.edges.reserve(2 * points_on_lines.size());
+    for (uint32_t l = 0; l < lines.size(); l++) {
+        auto begin = points_on_lines.begin() + offsets[l];
+        auto end = std::unique(begin, points_on_lines.begin() + offsets[l + 1]);
+        for (auto it = begin; it + 1 < end; it++) {
+            dcel.edges.push_back({(uint32_t) *it, 0, 0, l});
+            dcel.edges.push_back({(uint32_t) *(it + 1), 0, 0, l});
+        }
+    }
+    link_faces(dcel, lines, threads_count);
+}
+
+void lines_to_DCEL(std::vector<line<int>> &input_lines, DCEL &dcel,
+                   int threads_count = std::max(1u, std::thread::hardware_concurrency())) {
+    std::vector<line<int>> lines = normalize_lines(input_lines);
+    build_DCEL(lines, dcel, threads_count, [](const homogeneous_point &) {
+        return true;
+    });
+}
+
+class window {
+public:
+    int min_x;
+    int min_y;
+    int max_x;
+    int max_y;
+
+    bool contains(const homogeneous_point &p) const {
+        return min_x * p.w <= p.x && p.x <= max_x * p.w && min_y * p.w <= p.y && p.y <= max_y * p.w;
+    }
+
+    // whether the line passes through the inside of the window, not just along its border
+    bool crosses(const line<int> &l) const {
+        int sides[4] = {sign(l.a * min_x + l.b * min_y + l.c), sign(l.a * max_x + l.b * min_y + l.c),
+                        sign(l.a * max_x + l.b * max_y + l.c), sign(l.a * min_x + l.b * max_y + l.c)};
+        return *std::min_element(sides, sides + 4) < 0 && *std::max_element(sides, sides + 4) > 0;
+    }
+};
+
+// the part of the arrangement inside the window, whose sides are added as lines; only the lines crossing
+// the window and their intersections inside it are built, every face with positive area is a clipped face
+void window_to_DCEL(std::vector<line<int>> &input_lines, const window &w, DCEL &dcel,
+                    int threads_count = std::max(1u, std::thread::hardware_concurrency())) {
+    std::vector<line<int>> lines;
+    for (line<int> &l : normalize_lines(input_lines)) {
+        if (w.crosses(l)) {
+            lines.push_back(l);
+        }
+    }
+    std::vector<line<int>> sides = {line<int>({w.min_x, w.min_y}, {w.max_x, w.min_y}),
+                                    line<int>({w.max_x, w.min_y}, {w.max_x, w.max_y}),
+                                    line<int>({w.max_x, w.max_y}, {w.min_x, w.max_y}),
+                                    line<int>({w.min_x, w.max_y}, {w.min_x, w.min_y})};
+    for (line<int> &side : sides) {
+        lines.push_back(side.normalized());
+    }
+    build_DCEL(lines, dcel, threads_count, [&](const homogeneous_point &p) {
+        return w.contains(p);
+    });
+}
+
+std::vector<long double> compute_faces_square(const DCEL &dcel) {
+    std::vector<long double> doubled(dcel.faces.size(), 0);
+    for (uint32_t e = 0; e < dcel.edges.size(); e++) {
+        const point<long double> &s = dcel.vertices[dcel.edges[e].origin];
+        const point<long double> &t = dcel.vertices[dcel.target(e)];
+        doubled[dcel.edges[e].face] += s.x * t.y - s.y * t.x;
+    }
+    std::vector<long double> squares;
+    for (long double square : doubled) {
+        if (square > 0) {
+            squares.push_back(square / 2);
         }
     }
-    return {vertices, edges};
+    return squares;
 }
 
+// d strictly inside the counter-clockwise wedge from g to h
 template<typename T>
-int sgn(T x) {
-    return (x > 0) - (x < 0);
+bool is_inside_wedge(T gx, T gy, T dx, T dy, T hx, T hy) {
+    if (cross(gx, gy, hx, hy) > 0) {
+        return cross(gx, gy, dx, dy) > 0 && cross(dx, dy, hx, hy) > 0;
+    }
+    return !(cross(hx, hy, dx, dy) >= 0 && cross(dx, dy, gx, gy) >= 0);
 }
 
-std::vector<long double> compute_faces_square(DCEL dcel) {
-    auto vertices = dcel.vertices;
-    auto edges = dcel.edges;
-    for (edge *e : edges) {
-        vertices[e->e_index].edges.push_back(e);
-    }
-    for (auto v : vertices) {
-        int x = 1;
-        std::sort(v.edges.begin(), v.edges.end(), [&](edge *a, edge *b) {
-            long double ay = vertices[a->s_index].p.y;
-            long double by = vertices[b->s_index].p.y;
-            int a_above = sgn(ay - v.p.y);
-            int b_above = sgn(by - v.p.y);
-            long double ax = vertices[a->s_index].p.x;
-            long double bx = vertices[b->s_index].p.x;
-            if (a_above >= 0 && b_above == -1) {
-                return true;
+// arrangement of lines clipped to a box around all their intersections; a line is inserted by walking the zone
+// of faces it crosses and splitting them, and the areas of the bounded faces are kept in a multiset.
+// Exact for lines through points with |coordinates| < 2^19, which keeps the box side in 64 bits and the
+// crossings with it in 128; lines beyond the bound are refused
+class incremental_arrangement {
+public:
+    static const uint32_t OUTSIDE = 0;
+    static const uint32_t BOX_LINES = 4;
+    static const long long MAX_COORDINATE = (1 << 19) - 1;
+
+    typedef line<int>::W W;
+
+    long long coordinate_bound;
+    __int128 bound;
+    std::vector<line<int>> lines;
+    std::set<line<int>> inserted;
+    std::vector<homogeneous_point> vertices;
+    std::vector<point<long double>> coordinates;
+    std::vector<uint32_t> vertex_edges;
+    std::vector<half_edge> edges;
+    std::vector<uint32_t> prev;
+    std::vector<uint32_t> face_edges;
+    std::vector<long double> face_areas;
+    std::multiset<long double> areas;
+
+    // a bound on |coordinates| of the points the lines are given by, at most MAX_COORDINATE
+    explicit incremental_arrangement(long long requested_bound)
+            : coordinate_bound(requested_bound < MAX_COORDINATE ? std::max(0LL, requested_bound) : MAX_COORDINATE) {
+        // intersections of such lines stay below 16 * bound^3 in absolute value
+        long long b = 16 * coordinate_bound * coordinate_bound * coordinate_bound + 1;
+        bound = b;
+        lines = {box_line(0, 1, b), box_line(1, 0, -b), box_line(0, 1, -b), box_line(1, 0, b)};
+        uint32_t corners[4] = {add_vertex({-b, -b, 1}), add_vertex({b, -b, 1}), add_vertex({b, b, 1}),
+                               add_vertex({-b, b, 1})};
+        uint32_t bottom = add_edge_pair(corners[0], corners[1], 0);
+        uint32_t right = add_edge_pair(corners[1], corners[2], 1);
+        uint32_t top = add_edge_pair(corners[3], corners[2], 2);
+        uint32_t left = add_edge_pair(corners[0], corners[3], 3);
+        uint32_t inner[4] = {bottom, right, top + 1, left + 1};
+        uint32_t outer[4] = {left, top, right + 1, bottom + 1};
+        for (int i = 0; i < 4; i++) {
+            link(inner[i], inner[(i + 1) % 4]);
+            link(outer[i], outer[(i + 1) % 4]);
+            vertex_edges[corners[i]] = inner[i];
+        }
+        face_edges = {outer[0], inner[0]};
+        face_areas = {-1, -1};
+        set_face(OUTSIDE, outer[0]);
+        set_face(1, inner[0]);
+    }
+
+    static line<int> box_line(long long a, long long b, long long c) {
+        line<int> l{};
+        l.a = a;
+        l.b = b;
+        l.c = c;
+        return l;
+    }
+
+    uint32_t add_vertex(const homogeneous_point &p) {
+        vertices.push_back(p);
+        coordinates.push_back(p.to_point());
+        vertex_edges.push_back(0);
+        return vertices.size() - 1;
+    }
+
+    // the half-edge from -> to goes lexicographically forward along the line, its twin back
+    uint32_t add_edge_pair(uint32_t from, uint32_t to, uint32_t line) {
+        uint32_t e = edges.size();
+        edges.push_back({from, 0, 0, line});
+        edges.push_back({to, 0, 0, line});
+        prev.resize(edges.size());
+        return e;
+    }
+
+    void link(uint32_t a, uint32_t b) {
+        edges[a].next = b;
+        prev[b] = a;
+    }
+
+    uint32_t target(uint32_t e) const {
+        return edges[e ^ 1].origin;
+    }
+
+    void direction(uint32_t e, W &x, W &y) const {
+        lines[edges[e].line].direction(x, y);
+        if (e & 1) {
+            x = -x;
+            y = -y;
+        }
+    }
+
+    // positive on the left of the line looking along its direction
+    int side(const line<int> &l, uint32_t v) const {
+        const homogeneous_point &p = vertices[v];
+        int result = sign((__int128) l.a * p.x + (__int128) l.b * p.y + (__int128) l.c * p.w);
+        return l.b < 0 || (l.b == 0 && l.a > 0) ? -result : result;
+    }
+
+    // the new vertex at p inside the edge of h, both halves keep the faces of the edge
+    uint32_t split_edge(uint32_t h, const homogeneous_point &p) {
+        uint32_t forward = h & ~1u;
+        uint32_t backward = forward | 1;
+        uint32_t t = edges[backward].origin;
+        uint32_t v = add_vertex(p);
+        uint32_t e = add_edge_pair(v, t, edges[forward].line);
+        edges[backward].origin = v;
+        edges[e].face = edges[forward].face;
+        edges[e + 1].face = edges[backward].face;
+        link(e, edges[forward].next);
+        link(forward, e);
+        link(prev[backward], e + 1);
+        link(e + 1, backward);
+        vertex_edges[v] = e;
+        vertex_edges[t] = e + 1;
+        return v;
+    }
+
+    // the edge leaving v whose left face contains the direction x, y near v
+    uint32_t wedge(uint32_t v, W x, W y) const {
+        for (uint32_t h = vertex_edges[v];;) {
+            uint32_t g = edges[h ^ 1].next;
+            W gx, gy, hx, hy;
+            direction(g, gx, gy);
+            direction(h, hx, hy);
+            if (is_inside_wedge(gx, gy, x, y, hx, hy)) {
+                return g;
             }
-            if (a_above == -1 && b_above >= 0) {
-                return false;
+            h = g;
+        }
+    }
+
+    // labels the cycle of start as face and adds its area to the multiset when it does not touch the box
+    void set_face(uint32_t face, uint32_t start) {
+        face_edges[face] = start;
+        bool bounded = true;
+        long double doubled = 0;
+        uint32_t e = start;
+        do {
+            edges[e].face = face;
+            bounded &= edges[e].line >= BOX_LINES;
+            const point<long double> &s = coordinates[edges[e].origin];
+            const point<long double> &t = coordinates[target(e)];
+            doubled += s.x * t.y - s.y * t.x;
+            e = edges[e].next;
+        } while (e != start);
+        face_areas[face] = bounded ? doubled / 2 : -1;
+        if (bounded) {
+            areas.insert(face_areas[face]);
+        }
+    }
+
+    // the vertex where the line enters the box, the box boundary is split there if needed
+    uint32_t entry_vertex(line<int> &l) {
+        homogeneous_point entry;
+        bool found = false;
+        for (uint32_t i = 0; i < BOX_LINES; i++) {
+            if (l.is_parallel(lines[i])) {
+                continue;
             }
-            if (a_above == 0 && b_above == 0) {
-                int a_left = sgn(ax - v.p.x);
-                int b_left = sgn(bx - v.p.x);
-                return a_left < b_left;
+            homogeneous_point p = l.intersection(lines[i]);
+            bool on_box = -bound * p.w <= p.x && p.x <= bound * p.w && -bound * p.w <= p.y && p.y <= bound * p.w;
+            if (on_box && (!found || p < entry)) {
+                entry = p;
+                found = true;
             }
-            int turn = sgn((ax - v.p.x) * (by - v.p.y) - (bx - v.p.x) * (ay - v.p.y));
-            return turn < 0;
-        });
-        for (int i = 0; i + 1 < v.edges.size(); i++) {
-            v.edges[i]->next = v.edges[i + 1]->twin;
-            v.edges[i + 1]->twin->prev = v.edges[i];
         }
-        if (v.edges.size() >= 2) {
-            v.edges[v.edges.size() - 1]->next = v.edges[0]->twin;
-            v.edges[0]->twin->prev = v.edges[v.edges.size() - 1];
+        for (uint32_t h = face_edges[OUTSIDE];; h = edges[h].next) {
+            if (vertices[edges[h].origin] == entry) {
+                return edges[h].origin;
+            }
+            line<int> &boundary = lines[edges[h].line];
+            if (side(l, edges[h].origin) * side(l, target(h)) < 0
+                && (__int128) boundary.a * entry.x + (__int128) boundary.b * entry.y + (__int128) boundary.c * entry.w == 0) {
+                return split_edge(h, entry);
+            }
         }
     }
-    std::vector<long double> squares;
-    for (int i = 0; i < edges.size(); i++) {
-        if (edges[i]->has_face) {
-            continue;
+
+    bool is_within_bound(const point<int> &p) const {
+        return std::abs((long long) p.x) <= coordinate_bound && std::abs((long long) p.y) <= coordinate_bound;
+    }
+
+    // false if the line is already there or a point it is given by is outside the coordinate bound
+    bool insert(line<int> l) {
+        if (!is_within_bound(l.s) || !is_within_bound(l.e)) {
+            return false;
         }
-        int cur = i;
-        long double square = 0;
-        bool face = false;
-        while (true) {
-            edges[cur]->has_face = true;
-            point<long double> s = vertices[edges[cur]->s_index].p;
-            point<long double> e = vertices[edges[cur]->e_index].p;
-            square += s.x * e.y - s.y * e.x;
-            if (edges[i]->next == nullptr) {
-                break;
+        l = l.normalized();
+        if (!inserted.insert(l).second) {
+            return false;
+        }
+        uint32_t id = lines.size();
+        lines.push_back(l);
+        W x, y;
+        l.direction(x, y);
+        uint32_t p = entry_vertex(l);
+        for (uint32_t b = wedge(p, x, y); edges[b].face != OUTSIDE; b = wedge(p, x, y)) {
+            uint32_t face = edges[b].face;
+            // the line leaves the convex face where its boundary crosses from the right side to the left one
+            uint32_t c = b;
+            while (!(side(l, edges[c].origin) < 0 && side(l, target(c)) >= 0)) {
+                c = edges[c].next;
             }
-            int next = edges[cur]->next->index;
-            if (next == i) {
-                face = true;
-                break;
+            uint32_t q = target(c);
+            if (side(l, q) != 0) {
+                q = split_edge(c, l.intersection(lines[edges[c].line]));
+                if (target(c) != q) {
+                    c = prev[c];
+                }
             }
-            cur = next;
-        }
-        if (face && square > 0) {
-            squares.push_back(square / 2);
+            if (face_areas[face] >= 0) {
+                areas.erase(areas.find(face_areas[face]));
+            }
+            uint32_t a = prev[b];
+            uint32_t e = edges[c].next;
+            uint32_t g = add_edge_pair(p, q, id);
+            link(a, g);
+            link(g, e);
+            link(c, g + 1);
+            link(g + 1, b);
+            face_edges.push_back(g);
+            face_areas.push_back(-1);
+            set_face(face_edges.size() - 1, g);
+            set_face(face, g + 1);
+            p = q;
         }
+        return true;
     }
-    return squares;
+};
+
+class face_polygon {
+public:
+    std::vector<point<long double>> vertices;
+    long double square;
 
+    bool operator<(const face_polygon &other) const {
+        return square < other.square;
+    }
+};
+
+// counter-clockwise boundaries of the faces with positive area
+std::vector<face_polygon> compute_face_polygons(const DCEL &dcel) {
+    std::vector<face_polygon> polygons;
+    for (uint32_t start : dcel.faces) {
+        face_polygon polygon;
+        long double doubled = 0;
+        uint32_t e = start;
+        do {
+            const point<long double> &s = dcel.vertices[dcel.edges[e].origin];
+            const point<long double> &t = dcel.vertices[dcel.target(e)];
+            polygon.vertices.push_back(s);
+            doubled += s.x * t.y - s.y * t.x;
+            e = dcel.edges[e].next;
+        } while (e != start);
+        if (doubled > 0) {
+            polygon.square = doubled / 2;
+            polygons.push_back(polygon);
+        }
+    }
+    return polygons;
 }
 
-void solveJ() {
-    int x1, y1, x2, y2;
-    int n;
-    std::cin >> n;
+// every face as its area, vertex count and vertices on one line
+void solve_window(std::vector<line<int>> &lines, const window &w, output_writer &out) {
+    DCEL dcel;
+    window_to_DCEL(lines, w, dcel);
+    std::vector<face_polygon> polygons = compute_face_polygons(dcel);
+    std::sort(polygons.begin(), polygons.end());
+    long double min_s = 1e-8;
+    std::vector<face_polygon> result;
+    for (face_polygon &polygon : polygons) {
+        if (polygon.square >= min_s) {
+            result.push_back(polygon);
+        }
+    }
+    out.write_integer(result.size());
+    out.write('\n');
+    for (face_polygon &polygon : result) {
+        out.write_fixed(polygon.square, 9);
+        out.write(' ');
+        out.write_integer(polygon.vertices.size());
+        for (point<long double> &p : polygon.vertices) {
+            out.write(' ');
+            out.write_fixed(p.x, 9);
+            out.write(' ');
+            out.write_fixed(p.y, 9);
+        }
+        out.write('\n');
+    }
+}
 
+void solveJ(const window *w, bool binary) {
     std::vector<line<int>> lines;
-    for (int i = 0; i < n; i++) {
-        std::cin >> x1 >> y1 >> x2 >> y2;
-        line<int> line({x1, y1}, {x2, y2});
-        lines.push_back(line);
-    }
-    auto dcel = lines_to_DCEL(lines);
-    auto squares = compute_faces_square(dcel);
-    std::sort(squares.begin(), squares.end());
+    {
+        INSTRUMENT_PHASE("read");
+        input_reader input;
+        int n = input.read<int>();
+        for (int i = 0; i < n; i++) {
+            point<int> s = input.read_point<int>();
+            point<int> e = input.read_point<int>();
+            lines.emplace_back(s, e);
+        }
+    }
+    output_writer out(1, binary);
+    if (w != nullptr) {
+        solve_window(lines, *w, out);
+        return;
+    }
+    DCEL dcel;
+    {
+        INSTRUMENT_PHASE("arrangement");
+        lines_to_DCEL(lines, dcel);
+    }
+    std::vector<long double> squares;
+    {
+        INSTRUMENT_PHASE("faces");
+        squares = compute_faces_square(dcel);
+        std::sort(squares.begin(), squares.end());
+    }
+    INSTRUMENT_PHASE("output");
     long double min_s = 1e-8;
     std::vector<long double> result;
     for (long double &s : squares) {
@@ -224,12 +727,29 @@ void solveJ() {
             result.push_back(s);
         }
     }
-    std::cout << result.size() << '\n';
+    out.write_integer(result.size());
+    out.write('\n');
     for (long double s : result) {
-        std::cout << std::fixed << std::setprecision(9) << s << '\n';
+        out.write_fixed(s, 9);
+        out.write('\n');
     }
+    out.flush();
 }
 
-int main() {
-    solveJ();
+// j [--window <min x> <min y> <max x> <max y>] [--binary]
+int main(int argc, char **argv) {
+    window w{};
+    bool windowed = false;
+    bool binary = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::string(argv[i]) == "--window" && i + 4 < argc) {
+            w = {std::stoi(argv[i + 1]), std::stoi(argv[i + 2]), std::stoi(argv[i + 3]), std::stoi(argv[i + 4])};
+            windowed = true;
+            i += 4;
+        } else if (std::string(argv[i]) == "--binary") {
+            binary = true;
+        }
+    }
+    solveJ(windowed ? &w : nullptr, binary);
+    return 0;
 }
\ No newline at end of file
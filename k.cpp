@@ -3,23 +3,12 @@
 #include <algorithm>
 #include <iomanip>
 #include <cmath>
+#include <climits>
+#include <map>
+#include <string>
 
-template<typename T>
-class point {
-public:
-    T x;
-    T y;
-
-    point() = default;
-
-    point(T x, T y) : x(x), y(y) {}
-};
-
-template<typename T>
-int left_turn(point<T> &s, point<T> from, point<T> to) {
-    T cross_product = (from.x - s.x) * (to.y - s.y) - (to.x - s.x) * (from.y - s.y);
-    return (cross_product > 0) - (cross_product < 0);
-}
+#include "geometry.h"
+#include "input.h"
 
 template<typename T>
 void set_lowest_point_to_head(std::vector<point<T>> &points) {
@@ -51,9 +40,29 @@ std::vector<point<T>> convex_hull(std::vector<point<T>> &points) {
     return hull;
 }
 
+// Andrew's monotone chain over points sorted by x, then y, without repeats: the counter-clockwise hull
+// from the lowest of the leftmost points, without collinear vertices, in linear time
 template<typename T>
-T det(T x1, T y1, T x2, T y2) {
-    return std::abs(x1 * y2 - x2 * y1);
+std::vector<point<T>> monotone_chain(const std::vector<point<T>> &points) {
+    if (points.size() <= 1) {
+        return points;
+    }
+    std::vector<point<T>> hull(2 * points.size());
+    size_t size = 0;
+    for (size_t i = 0; i < points.size(); i++) {
+        while (size >= 2 && left_turn(hull[size - 2], hull[size - 1], points[i]) <= 0) {
+            size--;
+        }
+        hull[size++] = points[i];
+    }
+    for (size_t i = points.size() - 1, lower = size + 1; i-- > 0;) {
+        while (size >= lower && left_turn(hull[size - 2], hull[size - 1], points[i]) <= 0) {
+            size--;
+        }
+        hull[size++] = points[i];
+    }
+    hull.resize(size - 1);
+    return hull;
 }
 
 template<typename T>
@@ -61,11 +70,6 @@ T squared_len(T x1, T y1, T x2, T y2) {
     return (x1 - x2) * (x1 - x2) + (y1 - y2) * (y1 - y2);
 }
 
-template<typename T>
-T squared_len(T x, T y) {
-    return x * x + y * y;
-}
-
 template<typename T>
 T max(T a, T b) {
     if (a < b) {
@@ -74,76 +78,474 @@ T max(T a, T b) {
     return a;
 }
 
+// counter-clockwise convex hull without collinear vertices, built once and shared by the queries
 template<typename T>
-int sgn(T x) {
-    return (x > 0) - (x < 0);
+class prepared_hull {
+public:
+    std::vector<point<T>> vertices;
+
+    // coinciding points leave the same vertex twice
+    explicit prepared_hull(std::vector<point<T>> &points) : vertices(convex_hull(points)) {
+        if (vertices.size() == 2 && vertices[0] == vertices[1]) {
+            vertices.pop_back();
+        }
+    }
+
+    int size() const {
+        return vertices.size();
+    }
+
+    // the edge from vertex i to the next one
+    void edge(int i, T &x, T &y) const {
+        const point<T> &next = vertices[(i + 1) % vertices.size()];
+        x = next.x - vertices[i].x;
+        y = next.y - vertices[i].y;
+    }
+};
+
+template<typename T>
+class calipers_result {
+public:
+    typename wider<T>::type squared_diameter;
+    long double width;
+    long double min_area_rectangle;
+    long double min_perimeter_rectangle;
+};
+
+// one walk over the edges keeping the farthest vertex from the edge and the extreme vertices along it;
+// pointers advance on exact integer cross and dot products, only the reported lengths are rounded
+template<typename T>
+calipers_result<T> rotating_calipers(const prepared_hull<T> &hull) {
+    typedef typename wider<T>::type W;
+    const std::vector<point<T>> &p = hull.vertices;
+    int h = hull.size();
+    calipers_result<T> result = {0, 0, 0, 0};
+    if (h <= 1) {
+        return result;
+    }
+    auto squared_distance = [&](int i, int j) {
+        W x = (W) p[i % h].x - p[j % h].x;
+        W y = (W) p[i % h].y - p[j % h].y;
+        return x * x + y * y;
+    };
+    // the caliper along edge i turns by the edge leaving vertex j
+    auto step = [&](int i, int j, bool along) {
+        T x, y, jx, jy;
+        hull.edge(i % h, x, y);
+        hull.edge(j % h, jx, jy);
+        return along ? dot(x, y, jx, jy) : cross(x, y, jx, jy);
+    };
+    result.width = INFINITY;
+    result.min_area_rectangle = INFINITY;
+    result.min_perimeter_rectangle = INFINITY;
+    int far = 1;
+    int right = 1;
+    int left = 1;
+    for (int i = 0; i < h; i++) {
+        while (step(i, far, false) > 0) {
+            far++;
+        }
+        if (step(i, far, false) == 0) {
+            result.squared_diameter = max(result.squared_diameter, max(squared_distance(i, far + 1),
+                                                                       squared_distance(i + 1, far + 1)));
+        }
+        result.squared_diameter = max(result.squared_diameter, max(squared_distance(i, far),
+                                                                   squared_distance(i + 1, far)));
+        while (step(i, right, true) > 0) {
+            right++;
+        }
+        left = std::max(left, far);
+        while (step(i, left, true) < 0) {
+            left++;
+        }
+        T x, y;
+        hull.edge(i, x, y);
+        const point<T> &s = p[i];
+        long double length = std::sqrt((long double) dot(x, y, x, y));
+        long double height = (long double) cross(x, y, (T) (p[far % h].x - s.x), (T) (p[far % h].y - s.y)) / length;
+        long double extent = (long double) dot(x, y, (T) (p[right % h].x - p[left % h].x),
+                                               (T) (p[right % h].y - p[left % h].y)) / length;
+        result.width = std::min(result.width, height);
+        result.min_area_rectangle = std::min(result.min_area_rectangle, height * extent);
+        result.min_perimeter_rectangle = std::min(result.min_perimeter_rectangle, 2 * (height + extent));
+    }
+    return result;
+}
+
+// the diameter half of the calipers alone over counter-clockwise hull vertices, for queries needing nothing else
+template<typename T>
+typename wider<T>::type hull_squared_diameter(const std::vector<point<T>> &p) {
+    typedef typename wider<T>::type W;
+    int h = p.size();
+    W result = 0;
+    auto next = [h](int i) {
+        return i + 1 == h ? 0 : i + 1;
+    };
+    auto squared_distance = [&](int i, int j) {
+        W x = (W) p[i].x - p[j].x;
+        W y = (W) p[i].y - p[j].y;
+        return x * x + y * y;
+    };
+    auto turn = [&](int i, int j) {
+        return cross((T) (p[next(i)].x - p[i].x), (T) (p[next(i)].y - p[i].y),
+                     (T) (p[next(j)].x - p[j].x), (T) (p[next(j)].y - p[j].y));
+    };
+    int far = h > 1 ? 1 : 0;
+    for (int i = 0; i < h && h > 1; i++) {
+        while (turn(i, far) > 0) {
+            far = next(far);
+        }
+        if (turn(i, far) == 0) {
+            result = max(result, max(squared_distance(i, next(far)), squared_distance(next(i), next(far))));
+        }
+        result = max(result, max(squared_distance(i, far), squared_distance(next(i), far)));
+    }
+    return result;
 }
 
 template<typename T>
 T diameter(std::vector<point<T>> &points) {
-    auto hull = convex_hull(points);
-    int l = 0;
-    for (int i = 0; i < hull.size(); i++) {
-        if (hull[i].x < hull[l].x) {
-            l = i;
-        }
-    }
-    int r = 0;
-    for (int i = 0; i < hull.size(); i++) {
-        if (hull[i].x > hull[r].x) {
-            r = i;
-        }
-    }
-    int r_s = r;
-    int l_s = l;
-    T x = 0;
-    T y = -1;
-    T max_squared_distance = 0;
-    while (true) {
-        max_squared_distance = max(max_squared_distance,
-                                   squared_len(hull[l].x, hull[l].y, hull[r].x, hull[r].y));
-        int lnext = (l + 1) % hull.size();
-        int rnext = (r + 1) % hull.size();
-        T lx = (hull[lnext].x - hull[l].x);
-        T ly = (hull[lnext].y - hull[l].y);
-        T rx = (hull[rnext].x - hull[r].x);
-        T ry = (hull[rnext].y - hull[r].y);
-        long double ldet = det(x, y, lx, ly);
-        long double rdet = det(-x, -y, rx, ry);
-        ldet *= ldet;
-        ldet /= (long double) squared_len(lx, ly);
-        rdet *= rdet;
-        rdet /= (long double) squared_len(rx, ry);
-        long long lscal = sgn(x * lx + y * ly);
-        long long rscal = sgn(-x * rx - y * ry);
-        if ((lscal * rscal > 0 && ldet < rdet) || (lscal * rscal <= 0 && lscal >= rscal)) {
-            if (lnext == l_s) {
+    return rotating_calipers(prepared_hull<T>(points)).squared_diameter;
+}
+
+template<typename T>
+class approximate_diameter_result {
+public:
+    // exact, between two of the input points
+    typename wider<T>::type squared_diameter;
+    // the true diameter is at most this
+    long double upper_bound;
+};
+
+// of a non-empty set of points
+template<typename T>
+typename wider<T>::type exact_squared_diameter(std::vector<point<T>> &points) {
+    return points.size() <= 2 ? squared_len<typename wider<T>::type>(points[0].x, points[0].y,
+                                                                     points.back().x, points.back().y)
+                              : rotating_calipers(prepared_hull<T>(points)).squared_diameter;
+}
+
+// the extreme points along k integer directions spread over a half turn are kept as the points stream by,
+// and their exact diameter is within 1 / cos(gap / 2) of the true one, gap being the largest angle between
+// neighbouring directions; k ~ pi / sqrt(8 eps) keeps that under 1 + eps in O(k) memory. |coordinates| < 2^40
+template<typename T>
+class approximate_diameter {
+public:
+    std::vector<long long> dx, dy;
+    std::vector<long long> max_projection, min_projection;
+    std::vector<point<T>> max_point, min_point;
+    long double gap;
+    // eps <= 0 asks for the exact diameter, which is also cheaper once the directions outnumber the points:
+    // then every point is kept instead
+    bool exact;
+    std::vector<point<T>> points;
+    size_t count;
+
+    // for n points to come
+    approximate_diameter(size_t n, long double eps) : gap(0), count(0) {
+        const long double PI = std::acos(-1.0L);
+        const long long RESOLUTION = 1 << 20;
+        long double directions = std::ceil(PI / (2 * std::acos(1 / (1 + eps)))) + 1;
+        exact = !(eps > 0) || directions > n;
+        if (exact) {
+            return;
+        }
+        int k = std::max(2, (int) directions);
+        dx.resize(k);
+        dy.resize(k);
+        for (int j = 0; j < k; j++) {
+            dx[j] = std::llround(RESOLUTION * std::cos(PI * j / k));
+            dy[j] = std::llround(RESOLUTION * std::sin(PI * j / k));
+        }
+        max_projection.assign(k, LLONG_MIN);
+        min_projection.assign(k, LLONG_MAX);
+        max_point.resize(k);
+        min_point.resize(k);
+        gap = PI - std::atan2((long double) dy[k - 1], (long double) dx[k - 1]);
+        for (int j = 0; j + 1 < k; j++) {
+            gap = std::max(gap, std::atan2((long double) dy[j + 1], (long double) dx[j + 1])
+                                - std::atan2((long double) dy[j], (long double) dx[j]));
+        }
+    }
+
+    void add(const point<T> &p) {
+        count++;
+        if (exact) {
+            points.push_back(p);
+            return;
+        }
+        long long x = p.x;
+        long long y = p.y;
+        for (size_t j = 0; j < dx.size(); j++) {
+            long long projection = x * dx[j] + y * dy[j];
+            if (projection > max_projection[j]) {
+                max_projection[j] = projection;
+                max_point[j] = p;
+            }
+            if (projection < min_projection[j]) {
+                min_projection[j] = projection;
+                min_point[j] = p;
+            }
+        }
+    }
+
+    approximate_diameter_result<T> result() const {
+        approximate_diameter_result<T> result = {0, 0};
+        if (count == 0) {
+            return result;
+        }
+        std::vector<point<T>> candidates(points);
+        if (!exact) {
+            candidates = max_point;
+            candidates.insert(candidates.end(), min_point.begin(), min_point.end());
+            std::sort(candidates.begin(), candidates.end());
+            candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+        }
+        result.squared_diameter = exact_squared_diameter(candidates);
+        result.upper_bound = std::sqrt((long double) result.squared_diameter) / (exact ? 1 : std::cos(gap / 2));
+        return result;
+    }
+};
+
+// upper convex chain keyed by x; every insertion can be undone, most recent first
+template<typename T>
+class upper_chain {
+public:
+    class change {
+    public:
+        bool inserted;
+        T x;
+        int erased_count;
+    };
+
+    std::map<T, T> points;
+    std::vector<std::pair<T, T>> erased;
+    std::vector<change> changes;
+
+    // true when the chain changed
+    bool insert(T x, T y) {
+        change current = {false, x, 0};
+        auto erase = [&](typename std::map<T, T>::iterator it) {
+            erased.emplace_back(it->first, it->second);
+            current.erased_count++;
+            return points.erase(it);
+        };
+        auto it = points.lower_bound(x);
+        if (it != points.end() && it->first == x) {
+            if (it->second >= y) {
+                changes.push_back(current);
+                return false;
+            }
+            it = erase(it);
+        }
+        // below the chain
+        if (it != points.end() && it != points.begin()) {
+            auto left = std::prev(it);
+            if (orientation(left->first, left->second, it->first, it->second, x, y) <= 0) {
+                changes.push_back(current);
+                return false;
+            }
+        }
+        it = points.emplace_hint(it, x, y);
+        current.inserted = true;
+        while (it != points.begin() && std::prev(it) != points.begin()) {
+            auto b = std::prev(it);
+            auto a = std::prev(b);
+            if (orientation(a->first, a->second, b->first, b->second, x, y) < 0) {
                 break;
             }
-            x = lx;
-            y = ly;
-            l = lnext;
-        } else {
-            if (rnext == r_s) {
+            erase(b);
+        }
+        while (std::next(it) != points.end() && std::next(std::next(it)) != points.end()) {
+            auto c = std::next(it);
+            auto d = std::next(c);
+            if (orientation(x, y, c->first, c->second, d->first, d->second) < 0) {
                 break;
             }
-            x = -rx;
-            y = -ry;
-            r = rnext;
+            erase(c);
+        }
+        changes.push_back(current);
+        return true;
+    }
+
+    bool undo() {
+        change last = changes.back();
+        changes.pop_back();
+        if (last.inserted) {
+            points.erase(last.x);
+        }
+        for (int i = 0; i < last.erased_count; i++) {
+            points.insert(erased.back());
+            erased.pop_back();
+        }
+        return last.inserted || last.erased_count > 0;
+    }
+
+    void clear() {
+        points.clear();
+        erased.clear();
+        changes.clear();
+    }
+};
+
+// the lower chain is kept as the upper chain of the points mirrored in the x axis
+template<typename T>
+class incremental_hull {
+public:
+    upper_chain<T> upper;
+    upper_chain<T> lower;
+
+    // both true when the hull changed
+    bool insert(const point<T> &p) {
+        bool changed = upper.insert(p.x, p.y);
+        return lower.insert(p.x, -p.y) || changed;
+    }
+
+    bool undo() {
+        bool changed = upper.undo();
+        return lower.undo() || changed;
+    }
+
+    void clear() {
+        upper.clear();
+        lower.clear();
+    }
+
+    // the vertices of both chains merged by x, then y; the ends of the chains appear twice
+    void append_sorted_vertices(std::vector<point<T>> &vertices) const {
+        size_t first = vertices.size();
+        for (auto &p : upper.points) {
+            vertices.emplace_back(p.first, p.second);
+        }
+        size_t middle = vertices.size();
+        for (auto &p : lower.points) {
+            vertices.emplace_back(p.first, -p.second);
+        }
+        std::inplace_merge(vertices.begin() + first, vertices.begin() + middle, vertices.end());
+    }
+};
+
+template<typename T>
+class window_extent {
+public:
+    typename wider<T>::type squared_diameter;
+    typename wider<T>::type doubled_area;
+};
+
+// hull of the last `size` points of a stream as a queue of two stacks: arrivals go to the back stack and
+// its insertion-only hull, expiring points are popped from the front stack, whose hull undoes insertions.
+// When the front runs empty the back is moved over newest first, so every point is inserted and undone
+// at most once and updates cost O(log W) amortized. The aggregates are not maintained: a query merges the
+// x-sorted chains of the two hulls and runs the calipers over the result, O(h) for h vertices on the two
+// hulls and W when every point is on the hull. It is free while no hull changed since the last one
+template<typename T>
+class sliding_window_hull {
+public:
+    size_t size;
+    std::vector<point<T>> front;
+    std::vector<point<T>> back;
+    incremental_hull<T> front_hull;
+    incremental_hull<T> back_hull;
+    // the extent of the last query, kept while no hull changes
+    window_extent<T> last;
+    bool changed;
+    std::vector<point<T>> vertices;
+
+    explicit sliding_window_hull(size_t size) : size(size), last{0, 0}, changed(false) {}
+
+    void push(const point<T> &p) {
+        back.push_back(p);
+        changed |= back_hull.insert(p);
+        if (front.size() + back.size() > size) {
+            expire();
+        }
+    }
+
+    // moving the back over leaves the union of the two hulls as it was
+    void expire() {
+        if (front.empty()) {
+            while (!back.empty()) {
+                front.push_back(back.back());
+                front_hull.insert(back.back());
+                back.pop_back();
+            }
+            back_hull.clear();
         }
+        front.pop_back();
+        changed |= front_hull.undo();
+    }
+
+    window_extent<T> extent() {
+        if (!changed) {
+            return last;
+        }
+        changed = false;
+        vertices.clear();
+        front_hull.append_sorted_vertices(vertices);
+        size_t middle = vertices.size();
+        back_hull.append_sorted_vertices(vertices);
+        std::inplace_merge(vertices.begin(), vertices.begin() + middle, vertices.end());
+        vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+        last = {0, 0};
+        if (vertices.empty()) {
+            return last;
+        }
+        std::vector<point<T>> hull = monotone_chain(vertices);
+        last.squared_diameter = hull_squared_diameter(hull);
+        for (size_t i = 0; i < hull.size(); i++) {
+            const point<T> &a = hull[i];
+            const point<T> &b = hull[i + 1 == hull.size() ? 0 : i + 1];
+            last.doubled_area += cross(a.x, a.y, b.x, b.y);
+        }
+        last.doubled_area = last.doubled_area < 0 ? -last.doubled_area : last.doubled_area;
+        return last;
+    }
+};
+
+// the diameter and the hull area of the last `size` points after every arrival, in O(log W) amortized
+// for the update plus O(h) for the h hull vertices of the window: not polylog when the hull is large
+void solve_sliding_window(size_t size) {
+    std::ios::sync_with_stdio(false);
+    input_reader input;
+    size_t n = input.read<size_t>();
+    sliding_window_hull<long long> window(size);
+    for (size_t i = 0; i < n; i++) {
+        window.push(input.read_point<long long>());
+        window_extent<long long> extent = window.extent();
+        std::cout << std::fixed << std::setprecision(9) << std::sqrt((long double) extent.squared_diameter) << ' '
+                  << (long long) (extent.doubled_area / 2) << (extent.doubled_area % 2 != 0 ? ".5" : "") << '\n';
     }
-    return max_squared_distance;
 }
 
-void solveK() {
-    int n;
-    std::cin >> n;
-    std::vector<point<long long>> points;
-    for (int i = 0; i < n; i++) {
-        int x, y;
-        std::cin >> x >> y;
-        points.emplace_back(x, y);
+// the approximate diameter and the bound on the true one
+void solve_approximate(long double eps) {
+    std::ios::sync_with_stdio(false);
+    input_reader input;
+    size_t n = input.read<size_t>();
+    approximate_diameter<long long> stream(n, eps);
+    for (size_t i = 0; i < n; i++) {
+        stream.add(input.read_point<long long>());
     }
+    auto result = stream.result();
+    std::cout << std::fixed << std::setprecision(9) << std::sqrt((long double) result.squared_diameter) << ' '
+              << result.upper_bound << '\n';
+}
+
+// the diameter, the width and the smallest area and perimeter of an enclosing rectangle
+void solve_calipers() {
+    std::ios::sync_with_stdio(false);
+    input_reader input;
+    int n = input.read<int>();
+    std::vector<point<long long>> points = input.read_points<long long>(n);
+    calipers_result<long long> result = rotating_calipers(prepared_hull<long long>(points));
+    std::cout << std::fixed << std::setprecision(9) << std::sqrt((long double) result.squared_diameter) << ' '
+              << result.width << ' ' << result.min_area_rectangle << ' ' << result.min_perimeter_rectangle << '\n';
+}
+
+void solveK() {
+    input_reader input;
+    int n = input.read<int>();
+    std::vector<point<long long>> points = input.read_points<long long>(n);
     long long max_dist = 0;
     if (n <= 2) {
         for (point<long long> p : points) {
@@ -157,6 +559,17 @@ void solveK() {
     std::cout << std::fixed << std::setprecision(50) << std::sqrt((long double) max_dist) << '\n';
 }
 
-int main() {
-    solveK();
+// k [--approximate <eps> | --window <size> | --calipers]
+// --window costs O(h) per arrival for the h hull vertices of the window, up to O(size) on convex position
+int main(int argc, char **argv) {
+    if (argc == 2 && std::string(argv[1]) == "--calipers") {
+        solve_calipers();
+    } else if (argc == 3 && std::string(argv[1]) == "--approximate") {
+        solve_approximate(std::stold(argv[2]));
+    } else if (argc == 3 && std::string(argv[1]) == "--window") {
+        solve_sliding_window(std::stoul(argv[2]));
+    } else {
+        solveK();
+    }
+    return 0;
 }
\ No newline at end of file
@@ -0,0 +1,194 @@
+#ifndef GEOMETRY_OUTPUT_H
+#define GEOMETRY_OUTPUT_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+#include <unistd.h>
+
+// text goes into one reusable buffer that is written out in large blocks. In binary mode integers are native
+// int64 and decimals native double, separators and other text are dropped, so the values read back in order.
+// A writer without a file descriptor only collects, for answers assembled apart and written later in order
+class output_writer {
+private:
+    static const size_t CAPACITY = 1 << 16;
+
+    int fd;
+    bool binary;
+    std::vector<char> buffer;
+    size_t used;
+
+    // room for `size` more bytes, flushing first when there is a descriptor to flush to
+    char *reserve(size_t size) {
+        if (used + size > buffer.size()) {
+            if (fd >= 0) {
+                flush();
+            }
+            if (used + size > buffer.size()) {
+                buffer.resize(std::max(2 * buffer.size(), used + size));
+            }
+        }
+        return buffer.data() + used;
+    }
+
+    template<typename V>
+    void write_raw(V value) {
+        std::memcpy(reserve(sizeof(V)), &value, sizeof(V));
+        used += sizeof(V);
+    }
+
+    // two digits per division
+    template<typename T>
+    static size_t format_integer(char *out, T value) {
+        static const char DIGIT_PAIRS[] =
+                "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+                "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+                "8081828384858687888990919293949596979899";
+        typedef typename std::make_unsigned<T>::type U;
+        char digits[48];
+        char *end = digits + sizeof(digits);
+        char *p = end;
+        bool negative = value < 0;
+        U magnitude = negative ? U(0) - U(value) : U(value);
+        while (magnitude >= 100) {
+            unsigned pair = (unsigned) (magnitude % 100);
+            magnitude /= 100;
+            p -= 2;
+            std::memcpy(p, DIGIT_PAIRS + 2 * pair, 2);
+        }
+        if (magnitude >= 10) {
+            p -= 2;
+            std::memcpy(p, DIGIT_PAIRS + 2 * (unsigned) magnitude, 2);
+        } else {
+            *--p = (char) ('0' + (unsigned) magnitude);
+        }
+        if (negative) {
+            *--p = '-';
+        }
+        std::memcpy(out, p, end - p);
+        return end - p;
+    }
+
+public:
+    explicit output_writer(int fd = 1, bool binary = false) : fd(fd), binary(binary), buffer(CAPACITY), used(0) {}
+
+    output_writer(const output_writer &) = delete;
+
+    output_writer &operator=(const output_writer &) = delete;
+
+    ~output_writer() {
+        flush();
+    }
+
+    bool is_binary() const {
+        return binary;
+    }
+
+    void flush() {
+        if (fd < 0) {
+            return;
+        }
+        size_t written = 0;
+        while (written < used) {
+            ssize_t count = ::write(fd, buffer.data() + written, used - written);
+            if (count <= 0) {
+                break;
+            }
+            written += count;
+        }
+        used = 0;
+    }
+
+    // what a writer without a descriptor has collected so far
+    const char *data() const {
+        return buffer.data();
+    }
+
+    size_t size() const {
+        return used;
+    }
+
+    void clear() {
+        used = 0;
+    }
+
+    void write(char c) {
+        if (!binary) {
+            *reserve(1) = c;
+            used++;
+        }
+    }
+
+    void write(const char *text) {
+        if (!binary) {
+            write_bytes(text, std::strlen(text));
+        }
+    }
+
+    // copied as they are in both modes, for output formatted by another writer
+    void write_bytes(const char *data, size_t size) {
+        std::memcpy(reserve(size), data, size);
+        used += size;
+    }
+
+    template<typename T>
+    void write_integer(T value) {
+        if (binary) {
+            write_raw<int64_t>((int64_t) value);
+            return;
+        }
+        used += format_integer(reserve(48), value);
+    }
+
+    // the same text as std::fixed with std::setprecision(precision). Up to 15 digits the fraction is scaled in
+    // long double with an error far below the 10^-3 kept from a rounding tie, everything else goes to snprintf
+    void write_fixed(long double value, int precision) {
+        static const uint64_t POWERS[] = {
+                1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+                1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+                100000000000000ULL, 1000000000000000ULL};
+        if (binary) {
+            write_raw<double>((double) value);
+            return;
+        }
+        long double magnitude = std::fabs(value);
+        if (precision >= 0 && precision <= 15 && magnitude < 9e18L) {
+            long double whole = std::floor(magnitude);
+            long double scaled = (magnitude - whole) * (long double) POWERS[precision];
+            long double lower = std::floor(scaled);
+            if (std::fabs(scaled - lower - 0.5L) > 1e-3L) {
+                uint64_t integer = (uint64_t) whole;
+                uint64_t fraction = (uint64_t) lower + (scaled - lower > 0.5L);
+                if (fraction == POWERS[precision]) {
+                    fraction = 0;
+                    integer++;
+                }
+                char *out = reserve(48);
+                char *p = out;
+                if (std::signbit(value)) {
+                    *p++ = '-';
+                }
+                p += format_integer(p, integer);
+                if (precision > 0) {
+                    *p++ = '.';
+                    char digits[24];
+                    size_t length = format_integer(digits, fraction);
+                    std::memset(p, '0', precision - length);
+                    std::memcpy(p + precision - length, digits, length);
+                    p += precision;
+                }
+                used += p - out;
+                return;
+            }
+        }
+        int length = std::snprintf(nullptr, 0, "%.*Lf", precision, value);
+        std::snprintf(reserve(length + 1), length + 1, "%.*Lf", precision, value);
+        used += length;
+    }
+};
+
+#endif //GEOMETRY_OUTPUT_H
@@ -0,0 +1,94 @@
+#ifndef GEOMETRY_PREDICATES_H
+#define GEOMETRY_PREDICATES_H
+
+#include <cstdint>
+
+#include "instrument.h"
+
+// type holding a product of two coordinate differences of T without overflow,
+// exact for every int and while |coordinates| < 2^62 for long long
+template<typename T>
+class wider {
+public:
+    typedef T type;
+};
+
+template<>
+class wider<int> {
+public:
+    typedef __int128 type;
+};
+
+template<>
+class wider<long> {
+public:
+    typedef __int128 type;
+};
+
+template<>
+class wider<long long> {
+public:
+    typedef __int128 type;
+};
+
+template<typename T>
+constexpr int sign(T value) noexcept {
+    return (value > 0) - (value < 0);
+}
+
+// |a| * |b| as the high and low halves of a 256-bit product
+inline void multiply_magnitudes(__int128 a, __int128 b, unsigned __int128 &high, unsigned __int128 &low) {
+    typedef unsigned __int128 U;
+    const U MASK = ~(uint64_t) 0;
+    U x = a < 0 ? -(U) a : (U) a;
+    U y = b < 0 ? -(U) b : (U) b;
+    U x0 = x & MASK, x1 = x >> 64, y0 = y & MASK, y1 = y >> 64;
+    U p00 = x0 * y0, p01 = x0 * y1, p10 = x1 * y0;
+    U middle = (p00 >> 64) + (p01 & MASK) + (p10 & MASK);
+    low = (middle << 64) | (p00 & MASK);
+    high = x1 * y1 + (p01 >> 64) + (p10 >> 64) + (middle >> 64);
+}
+
+// sign of a * b - c * d, exact for any 128-bit operands
+inline int compare_products(__int128 a, __int128 b, __int128 c, __int128 d) {
+    int left = sign(a) * sign(b);
+    int right = sign(c) * sign(d);
+    if (left != right) {
+        return left > right ? 1 : -1;
+    }
+    unsigned __int128 left_high, left_low, right_high, right_low;
+    multiply_magnitudes(a, b, left_high, left_low);
+    multiply_magnitudes(c, d, right_high, right_low);
+    int magnitude = left_high != right_high ? (left_high > right_high ? 1 : -1)
+                                            : (left_low > right_low) - (left_low < right_low);
+    return left * magnitude;
+}
+
+// x1 * y2 - y1 * x2
+template<typename T>
+constexpr typename wider<T>::type cross(T x1, T y1, T x2, T y2) noexcept {
+    typedef typename wider<T>::type W;
+    return (W) x1 * y2 - (W) y1 * x2;
+}
+
+// x1 * x2 + y1 * y2
+template<typename T>
+constexpr typename wider<T>::type dot(T x1, T y1, T x2, T y2) noexcept {
+    typedef typename wider<T>::type W;
+    return (W) x1 * x2 + (W) y1 * y2;
+}
+
+// sign of (p - s) x (q - s), the differences are taken in the wider type as well.
+// Every left_turn goes through here, so this is where the degenerate case is counted
+template<typename T>
+constexpr int orientation(T sx, T sy, T px, T py, T qx, T qy) noexcept {
+    typedef typename wider<T>::type W;
+    int turn = sign(((W) px - sx) * ((W) qy - sy) - ((W) py - sy) * ((W) qx - sx));
+    INSTRUMENT_COUNT("left_turn");
+    if (turn == 0) {
+        INSTRUMENT_COUNT("left_turn.zero");
+    }
+    return turn;
+}
+
+#endif //GEOMETRY_PREDICATES_H
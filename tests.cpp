@@ -0,0 +1,442 @@
+#include <bits/stdc++.h>
+
+#include "geometry.h"
+#include "input.h"
+#include "output.h"
+
+// checks of the library kernels that no solution main reaches, against brute force on seeded random inputs.
+// Every solution is compiled into its own namespace with its main renamed, as in bench.cpp
+#define main solution_main
+
+namespace g {
+#include "g.cpp"
+}
+
+namespace i {
+#include "i.cpp"
+}
+
+namespace j {
+#include "j.cpp"
+}
+
+namespace k {
+#include "k.cpp"
+}
+
+#undef main
+
+// a failed check names the case and what differed
+bool check(bool passed, const std::string &message) {
+    if (!passed) {
+        std::cerr << message << '\n';
+    }
+    return passed;
+}
+
+// counter-clockwise strictly convex polygon of up to n vertices around centre: the hull of points near a circle
+std::vector<point<long long>> random_convex_polygon(std::mt19937_64 &random, int n, point<long long> centre,
+                                                    long long radius) {
+    std::uniform_real_distribution<double> angle(0, 2 * M_PI);
+    std::vector<point<long long>> points(n);
+    for (point<long long> &p : points) {
+        double a = angle(random);
+        p = point<long long>(centre.x + (long long) (radius * std::cos(a)),
+                             centre.y + (long long) (radius * std::sin(a)));
+    }
+    std::sort(points.begin(), points.end());
+    points.erase(std::unique(points.begin(), points.end()), points.end());
+    std::vector<point<long long>> hull(2 * points.size());
+    size_t size = 0;
+    for (size_t pass = 0; pass < 2; pass++) {
+        size_t start = size;
+        for (const point<long long> &p : points) {
+            while (size >= start + 2 && left_turn(hull[size - 2], hull[size - 1], p) <= 0) {
+                size--;
+            }
+            hull[size++] = p;
+        }
+        size--;
+        std::reverse(points.begin(), points.end());
+    }
+    hull.resize(size);
+    return hull;
+}
+
+long double brute_segments_distance(point<long long> a, point<long long> b, point<long long> c, point<long long> d) {
+    if (left_turn(a, b, c) * left_turn(a, b, d) < 0 && left_turn(c, d, a) * left_turn(c, d, b) < 0) {
+        return 0;
+    }
+    return std::min(std::min(g::distance_to_segment(a, c, d), g::distance_to_segment(b, c, d)),
+                    std::min(g::distance_to_segment(c, a, b), g::distance_to_segment(d, a, b)));
+}
+
+bool brute_contains(const std::vector<point<long long>> &polygon, const point<long long> &p) {
+    for (size_t i = 0; i < polygon.size(); i++) {
+        if (left_turn(polygon[i], polygon[(i + 1) % polygon.size()], p) < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// every pair of edges, and 0 when a vertex of one polygon is inside the other
+long double brute_polygons_distance(const std::vector<point<long long>> &p, const std::vector<point<long long>> &q) {
+    if (brute_contains(p, q[0]) || brute_contains(q, p[0])) {
+        return 0;
+    }
+    long double distance = INFINITY;
+    for (size_t i = 0; i < p.size(); i++) {
+        for (size_t j = 0; j < q.size(); j++) {
+            distance = std::min(distance, brute_segments_distance(p[i], p[(i + 1) % p.size()],
+                                                                  q[j], q[(j + 1) % q.size()]));
+        }
+    }
+    return distance;
+}
+
+// overlapping, touching and separated polygons, one thread and several
+bool test_polygons_within_distance() {
+    std::mt19937_64 random(26);
+    bool passed = true;
+    for (int round = 0; round < 200 && passed; round++) {
+        std::uniform_int_distribution<long long> coordinate(-300, 300);
+        std::uniform_int_distribution<int> size(3, 12);
+        std::vector<std::vector<point<long long>>> polygons;
+        while (polygons.size() < 30) {
+            std::vector<point<long long>> polygon = random_convex_polygon(
+                    random, size(random), point<long long>(coordinate(random), coordinate(random)), 5 + random() % 60);
+            if (polygon.size() >= 3) {
+                polygons.push_back(polygon);
+            }
+        }
+        long double r = (long double) (random() % 4000) / 100;
+        std::set<std::pair<int, int>> expected;
+        std::set<std::pair<int, int>> borderline;
+        for (int a = 0; a < (int) polygons.size(); a++) {
+            for (int b = a + 1; b < (int) polygons.size(); b++) {
+                long double distance = brute_polygons_distance(polygons[a], polygons[b]);
+                if (std::abs(distance - r) < 1e-9) {
+                    borderline.insert({a, b});
+                } else if (distance < r) {
+                    expected.insert({a, b});
+                }
+            }
+        }
+        for (int threads : {1, 4}) {
+            std::set<std::pair<int, int>> found;
+            for (const std::pair<int, int> &pair : g::polygons_within_distance(polygons, r, threads)) {
+                if (borderline.count(pair) == 0) {
+                    found.insert(pair);
+                }
+            }
+            passed &= check(found == expected, "round " + std::to_string(round) + ", " + std::to_string(threads)
+                                               + " threads: " + std::to_string(found.size()) + " pairs found, "
+                                               + std::to_string(expected.size()) + " expected");
+        }
+    }
+    return passed;
+}
+
+// two polygons drifting through separation, touching and overlap, each warm query against a cold walk
+bool test_polygons_distance_query() {
+    std::mt19937_64 random(27);
+    std::uniform_int_distribution<long long> step(-3, 3);
+    bool passed = true;
+    for (int pair = 0; pair < 100 && passed; pair++) {
+        std::vector<point<long long>> p = random_convex_polygon(random, 3 + random() % 20, point<long long>(0, 0),
+                                                               10 + random() % 50);
+        std::vector<point<long long>> q = random_convex_polygon(random, 3 + random() % 20,
+                                                               point<long long>(150, random() % 100), 10 + random() % 50);
+        if (p.size() < 3 || q.size() < 3) {
+            continue;
+        }
+        g::polygons_distance_query<long long> query;
+        point<long long> drift(-1 - (long long) (random() % 2), step(random));
+        for (int frame = 0; frame < 300 && passed; frame++) {
+            // mostly a steady drift, now and then a jump
+            point<long long> move = frame % 50 == 49 ? point<long long>(step(random) * 10, step(random) * 10)
+                                                     : drift + point<long long>(step(random) / 3, step(random) / 3);
+            for (point<long long> &v : q) {
+                v = v + move;
+            }
+            if (frame == 150) {
+                drift = point<long long>(-drift.x, -drift.y);
+            }
+            long double warm = query(p, q);
+            long double cold = g::polygons_distance(p, q);
+            passed &= check(std::abs(warm - cold) <= 1e-9 * (1 + cold),
+                            "pair " + std::to_string(pair) + ", frame " + std::to_string(frame) + ": warm "
+                            + std::to_string((double) warm) + ", cold " + std::to_string((double) cold));
+        }
+    }
+    return passed;
+}
+
+// distinct random points joined in random order, then untangled by 2-opt moves until no two edges cross
+std::vector<point<long long>> random_simple_polygon(std::mt19937_64 &random, int n, long long range) {
+    std::uniform_int_distribution<long long> coordinate(-range, range);
+    std::set<point<long long>> distinct;
+    while ((int) distinct.size() < n) {
+        distinct.insert(point<long long>(coordinate(random), coordinate(random)));
+    }
+    std::vector<point<long long>> polygon(distinct.begin(), distinct.end());
+    std::shuffle(polygon.begin(), polygon.end(), random);
+    auto crossing = [&](int a, int b) {
+        const point<long long> &p = polygon[a], &q = polygon[(a + 1) % n];
+        const point<long long> &r = polygon[b], &s = polygon[(b + 1) % n];
+        return left_turn(p, q, r) * left_turn(p, q, s) <= 0 && left_turn(r, s, p) * left_turn(r, s, q) <= 0;
+    };
+    for (bool untangled = false; !untangled;) {
+        untangled = true;
+        for (int a = 0; a < n; a++) {
+            for (int b = a + 2; b < n && !(a == 0 && b == n - 1); b++) {
+                if (crossing(a, b)) {
+                    std::reverse(polygon.begin() + a + 1, polygon.begin() + b + 1);
+                    untangled = false;
+                }
+            }
+        }
+    }
+    return polygon;
+}
+
+// n - 3 diagonals cutting a counter-clockwise polygon into counter-clockwise triangles that cover its area
+bool is_triangulation(std::vector<point<long long>> &polygon, std::vector<std::pair<int, int>> &diagonals) {
+    int n = polygon.size();
+    std::vector<int> triangles(3 * (n - 2));
+    std::vector<int> neighbours(3 * (n - 2));
+    i::diagonal_graph graph;
+    i::triangle_mesh mesh = i::build_mesh(polygon, diagonals, triangles.data(), neighbours.data(), graph);
+    if ((int) diagonals.size() != n - 3 || mesh.size != n - 2) {
+        return false;
+    }
+    __int128 area = 0;
+    for (int v = 0; v < n; v++) {
+        area += cross_product(point<long long>(0, 0), polygon[v], polygon[(v + 1) % n]);
+    }
+    for (int t = 0; t < mesh.size; t++) {
+        __int128 doubled = cross_product(polygon[triangles[3 * t]], polygon[triangles[3 * t + 1]],
+                                         polygon[triangles[3 * t + 2]]);
+        if (doubled <= 0) {
+            return false;
+        }
+        area -= doubled;
+    }
+    return area == 0;
+}
+
+// the ear clipper and the monotone partition on star-shaped and on untangled random polygons
+bool test_triangulate_by_ears() {
+    std::mt19937_64 random(34);
+    std::uniform_real_distribution<double> unit(0, 1);
+    bool passed = true;
+    for (int round = 0; round < 4000 && passed; round++) {
+        int n = 4 + random() % 40;
+        std::vector<point<long long>> polygon;
+        if (round % 2 == 0) {
+            for (int v = 0; v < n; v++) {
+                double a = 2 * M_PI * (v + unit(random) * 0.5) / n;
+                double r = 1000000 * (0.2 + 0.8 * unit(random));
+                polygon.emplace_back((long long) (r * std::cos(a)), (long long) (r * std::sin(a)));
+            }
+        } else {
+            polygon = random_simple_polygon(random, n, 1000000);
+        }
+        if (i::is_clock_wise_orientation(polygon)) {
+            std::reverse(polygon.begin(), polygon.end());
+        }
+        i::diagonal_graph graph;
+        for (bool ears : {true, false}) {
+            std::vector<std::pair<int, int>> diagonals = i::triangulate(polygon, graph, ears);
+            passed &= check(is_triangulation(polygon, diagonals), "round " + std::to_string(round) + ", "
+                                                                   + (ears ? "ears" : "monotone") + ": "
+                                                                   + std::to_string(diagonals.size())
+                                                                   + " diagonals for " + std::to_string(n)
+                                                                   + " vertices");
+        }
+    }
+    return passed;
+}
+
+// n random lines through points with |coordinates| <= range, repeats and parallels included at small ranges
+std::vector<j::line<int>> random_lines(std::mt19937_64 &random, int n, int range) {
+    std::uniform_int_distribution<int> coordinate(-range, range);
+    std::vector<j::line<int>> lines;
+    while ((int) lines.size() < n) {
+        point<int> s(coordinate(random), coordinate(random));
+        point<int> e(coordinate(random), coordinate(random));
+        if (s != e) {
+            lines.emplace_back(s, e);
+        }
+    }
+    return lines;
+}
+
+// 1 - n + the sum of (lines through v) - 1 over the vertices: the bounded faces of n distinct lines in at least
+// two directions. Vertices are told apart as fractions in lowest terms, independently of the solution's order
+int bounded_faces(std::vector<j::line<int>> &lines) {
+    std::map<std::tuple<__int128, __int128, __int128>, std::set<int>> vertices;
+    bool directions = false;
+    for (int a = 0; a < (int) lines.size(); a++) {
+        for (int b = a + 1; b < (int) lines.size(); b++) {
+            if (lines[a].is_parallel(lines[b])) {
+                continue;
+            }
+            directions = true;
+            j::homogeneous_point p = lines[a].intersection(lines[b]);
+            __int128 g = std::__gcd(std::__gcd(p.x < 0 ? -p.x : p.x, p.y < 0 ? -p.y : p.y), p.w);
+            std::set<int> &through = vertices[std::make_tuple(p.x / g, p.y / g, p.w / g)];
+            through.insert(a);
+            through.insert(b);
+        }
+    }
+    if (!directions) {
+        return 0;
+    }
+    int faces = 1 - (int) lines.size();
+    for (auto &vertex : vertices) {
+        faces += (int) vertex.second.size() - 1;
+    }
+    return faces;
+}
+
+// the faces of lines_to_DCEL from tiny grids full of concurrent lines up to the whole int range
+bool test_lines_to_DCEL() {
+    std::mt19937_64 random(38);
+    const int RANGES[] = {10, 1000, 100000, 100000000, INT_MAX};
+    bool passed = true;
+    for (int round = 0; round < 500 && passed; round++) {
+        std::vector<j::line<int>> input = random_lines(random, 2 + random() % 24, RANGES[round % 5]);
+        std::vector<j::line<int>> lines = j::normalize_lines(input);
+        j::DCEL dcel;
+        j::lines_to_DCEL(input, dcel, 1 + round % 3);
+        int expected = bounded_faces(lines);
+        int found = j::compute_faces_square(dcel).size();
+        passed &= check(found == expected, "round " + std::to_string(round) + ": " + std::to_string(found)
+                                           + " faces, " + std::to_string(expected) + " expected");
+    }
+    return passed;
+}
+
+// the areas after every insertion against lines_to_DCEL over the lines so far, and lines beyond the bound refused
+bool test_incremental_arrangement() {
+    std::mt19937_64 random(40);
+    const int RANGES[] = {10, 1000, j::incremental_arrangement::MAX_COORDINATE};
+    bool passed = true;
+    for (int round = 0; round < 300 && passed; round++) {
+        int range = RANGES[round % 3];
+        std::vector<j::line<int>> input = random_lines(random, 2 + random() % 20, range);
+        j::incremental_arrangement arrangement(range);
+        std::vector<j::line<int>> prefix;
+        for (int step = 0; step < (int) input.size() && passed; step++) {
+            prefix.push_back(input[step]);
+            arrangement.insert(input[step]);
+            j::DCEL dcel;
+            j::lines_to_DCEL(prefix, dcel, 1);
+            std::vector<long double> expected = j::compute_faces_square(dcel);
+            std::sort(expected.begin(), expected.end());
+            std::vector<long double> found(arrangement.areas.begin(), arrangement.areas.end());
+            bool same = found.size() == expected.size();
+            for (size_t f = 0; same && f < found.size(); f++) {
+                same = std::abs(found[f] - expected[f]) <= 1e-9 * std::max<long double>(1, expected[f]);
+            }
+            passed &= check(same, "round " + std::to_string(round) + ", line " + std::to_string(step) + ": "
+                                  + std::to_string(found.size()) + " faces, " + std::to_string(expected.size())
+                                  + " expected");
+        }
+        j::line<int> beyond(point<int>(range + 1, 0), point<int>(-range, 1));
+        size_t faces = arrangement.areas.size();
+        passed &= check(!arrangement.insert(beyond) && arrangement.areas.size() == faces,
+                        "round " + std::to_string(round) + ": a line beyond the bound was inserted");
+    }
+    return passed;
+}
+
+// the diameter, and the extents across and along every direction through two distinct points: an optimal
+// rectangle has a side on a hull edge, so the minima over these directions are exact
+void brute_calipers(const std::vector<point<long long>> &points, long double &diameter, long double &width,
+                    long double &area, long double &perimeter) {
+    diameter = width = area = perimeter = 0;
+    bool found = false;
+    for (const point<long long> &a : points) {
+        for (const point<long long> &b : points) {
+            diameter = std::max(diameter, std::sqrt((long double) squared_distance(a, b)));
+            if (a == b) {
+                continue;
+            }
+            long double dx = b.x - a.x, dy = b.y - a.y, length = std::sqrt(dx * dx + dy * dy);
+            long double low_across = INFINITY, high_across = -INFINITY, low_along = INFINITY, high_along = -INFINITY;
+            for (const point<long long> &p : points) {
+                long double across = (dx * (p.y - a.y) - dy * (p.x - a.x)) / length;
+                long double along = (dx * (p.x - a.x) + dy * (p.y - a.y)) / length;
+                low_across = std::min(low_across, across);
+                high_across = std::max(high_across, across);
+                low_along = std::min(low_along, along);
+                high_along = std::max(high_along, along);
+            }
+            long double height = high_across - low_across, extent = high_along - low_along;
+            width = found ? std::min(width, height) : height;
+            area = found ? std::min(area, height * extent) : height * extent;
+            perimeter = found ? std::min(perimeter, 2 * (height + extent)) : 2 * (height + extent);
+            found = true;
+        }
+    }
+}
+
+// the four outputs of --calipers on small sets, with repeated and collinear points in the narrow ranges
+bool test_rotating_calipers() {
+    std::mt19937_64 random(43);
+    const long long RANGES[] = {2, 10, 1000000};
+    bool passed = true;
+    for (int round = 0; round < 3000 && passed; round++) {
+        long long range = RANGES[round % 3];
+        std::uniform_int_distribution<long long> coordinate(-range, range);
+        std::vector<point<long long>> points(1 + random() % 12);
+        for (point<long long> &p : points) {
+            p = point<long long>(coordinate(random), coordinate(random));
+        }
+        if (round % 7 == 0) {
+            for (point<long long> &p : points) {
+                p = point<long long>(p.x, 2 * p.x + 1);
+            }
+        }
+        long double diameter, width, area, perimeter;
+        brute_calipers(points, diameter, width, area, perimeter);
+        k::calipers_result<long long> result = k::rotating_calipers(k::prepared_hull<long long>(points));
+        auto close = [](long double found, long double expected) {
+            return std::abs(found - expected) <= 1e-9 * std::max<long double>(1, expected);
+        };
+        passed &= check(close(std::sqrt((long double) result.squared_diameter), diameter)
+                        && close(result.width, width) && close(result.min_area_rectangle, area)
+                        && close(result.min_perimeter_rectangle, perimeter),
+                        "round " + std::to_string(round) + ": " + std::to_string((double) result.width) + ' '
+                        + std::to_string((double) result.min_area_rectangle) + ' '
+                        + std::to_string((double) result.min_perimeter_rectangle) + ", expected "
+                        + std::to_string((double) width) + ' ' + std::to_string((double) area) + ' '
+                        + std::to_string((double) perimeter));
+    }
+    return passed;
+}
+
+// run as `tests <name>`, the exit code is 0 when the test passed
+int main(int argc, char **argv) {
+    const std::map<std::string, bool (*)()> TESTS = {
+            {"polygons_within_distance", test_polygons_within_distance},
+            {"polygons_distance_query", test_polygons_distance_query},
+            {"triangulate_by_ears", test_triangulate_by_ears},
+            {"lines_to_DCEL", test_lines_to_DCEL},
+            {"incremental_arrangement", test_incremental_arrangement},
+            {"rotating_calipers", test_rotating_calipers},
+    };
+    auto test = argc == 2 ? TESTS.find(argv[1]) : TESTS.end();
+    if (test == TESTS.end()) {
+        std::cerr << "usage: tests <name>, one of:";
+        for (auto &named : TESTS) {
+            std::cerr << ' ' << named.first;
+        }
+        std::cerr << '\n';
+        return 2;
+    }
+    return test->second() ? 0 : 1;
+}